@@ -24,62 +24,36 @@ static void on_music_toggled(bool enabled, void *ctx) // toggle callback demo
 
 #define MAX_ITEM_PANELS 4
 
-typedef struct PanelFade {
+#define PANEL_FADE_TIME 0.25f // seconds for item/info panels to fade in or out
+
+typedef struct ItemPanel {
     bool visible;
-    bool closing;
-    float alpha;
-    float speed;
+    unsigned int fadeId; // rui tween driving this panel's alpha
     Rectangle bounds;
     int itemIndex;
     const char *emoji;
     char title[32];
-} PanelFade;
-
-static float move_towards(float value, float target, float maxDelta)
-{
-    if (value < target) {
-        value += maxDelta;
-        if (value > target) value = target;
-    } else if (value > target) {
-        value -= maxDelta;
-        if (value < target) value = target;
-    }
-    return value;
-}
-
-static void panel_fade_update(PanelFade *panel, float dt)
-{
-    if (!panel->visible && panel->alpha <= 0.0f) return;
-    float target = panel->closing ? 0.0f : 1.0f;
-    panel->alpha = move_towards(panel->alpha, target, panel->speed * dt);
-    if (panel->closing && panel->alpha <= 0.01f) {
-        panel->alpha = 0.0f;
-        panel->closing = false;
-        panel->visible = false;
-    }
-}
+} ItemPanel;
 
 static const char *ITEM_EMOJIS[] = {
     "🍎", "🗡️", "🛡️", "🧪", "💎", "🔥", "⚙️", "🌟"
 };
 static const int ITEM_EMOJI_COUNT = (int)(sizeof(ITEM_EMOJIS) / sizeof(ITEM_EMOJIS[0]));
 
-static void open_item_panel(PanelFade *panels, int count, const Rectangle *slots, int itemIndex)
+static void open_item_panel(ItemPanel *panels, int count, const Rectangle *slots, int itemIndex)
 {
     int slot = -1;
     for (int i = 0; i < count; ++i) {
-        if (!panels[i].visible && panels[i].alpha <= 0.01f) {
+        if (!panels[i].visible && rui_tween_value(panels[i].fadeId, 0.0f) <= 0.01f) {
             slot = i;
             break;
         }
     }
     if (slot == -1) slot = 0;
 
-    PanelFade *panel = &panels[slot];
+    ItemPanel *panel = &panels[slot];
     panel->visible = true;
-    panel->closing = false;
-    panel->alpha = 0.0f;
-    panel->speed = 4.0f;
+    rui_tween_start(panel->fadeId, 0.0f, 1.0f, PANEL_FADE_TIME, RUI_EASE_OUT_QUAD);
     panel->bounds = slots[slot];
     panel->itemIndex = itemIndex;
     panel->emoji = ITEM_EMOJIS[itemIndex % ITEM_EMOJI_COUNT];
@@ -135,21 +109,17 @@ int main(void)
         {280, 400, 200, 160},
         {520, 400, 200, 160}
     };
-    PanelFade itemPanels[MAX_ITEM_PANELS] = {0};
+    ItemPanel itemPanels[MAX_ITEM_PANELS] = {0};
     for (int i = 0; i < MAX_ITEM_PANELS; ++i) {
         itemPanels[i].bounds = itemPanelSlots[i];
-        itemPanels[i].speed = 4.0f;
-        itemPanels[i].alpha = 0.0f;
+        itemPanels[i].fadeId = rui_hash_string(TextFormat("item panel %d", i), 0);
         itemPanels[i].visible = false;
-        itemPanels[i].closing = false;
         itemPanels[i].emoji = ITEM_EMOJIS[i % ITEM_EMOJI_COUNT];
         itemPanels[i].title[0] = '\0';
     }
 
-    bool infoVisible = true;
-    bool infoClosing = false;
-    float infoAlpha = 1.0f;
-    float infoFadeSpeed = 4.0f;
+    unsigned int infoFade = rui_hash_string("info panel", 0);
+    rui_tween_set(infoFade, 1.0f);
 
     // Game state
     Rectangle player = { screenWidth/2.0f - 20, screenHeight/2.0f - 20, 40, 40 };
@@ -164,27 +134,10 @@ int main(void)
     {
         // Update
         float dt = GetFrameTime();
+        if (dt > 0.1f) dt = 0.1f; // the first frame after waiting for events reports the whole idle gap
 
-        if (IsKeyPressed(KEY_I)) {
-            infoVisible = true;
-            infoClosing = false;
-            if (infoAlpha <= 0.0f) infoAlpha = 0.0f;
-        }
-
-        float infoTarget = infoVisible ? 1.0f : 0.0f;
-        infoAlpha = move_towards(infoAlpha, infoTarget, infoFadeSpeed * dt);
-        if (!infoVisible && infoAlpha <= 0.01f) {
-            infoAlpha = 0.0f;
-            infoClosing = false;
-        } else if (!infoVisible && infoAlpha > 0.0f) {
-            infoClosing = true;
-        } else if (infoVisible && infoAlpha >= 0.99f) {
-            infoClosing = false;
-        }
-
-        for (int i = 0; i < MAX_ITEM_PANELS; ++i) {
-            panel_fade_update(&itemPanels[i], dt);
-        }
+        if (IsKeyPressed(KEY_I)) rui_tween(infoFade, 1.0f, PANEL_FADE_TIME, RUI_EASE_OUT_QUAD); // fades back in from wherever it is
+        float infoAlpha = rui_tween_value(infoFade, 0.0f);
 
         bool uiCapturesKeyboard = rui_keyboard_captured();
 
@@ -206,7 +159,7 @@ int main(void)
 
             rui_begin_frame();
 
-            if (infoVisible || infoClosing || infoAlpha > 0.01f) {
+            if (infoAlpha > 0.01f) {
                 Rectangle infoPanel = { 400, 50, 200, 100 };
                 rui_panel_style infoStyle = {
                     .bodyColor = { 30, 60, 120, 230 }, // soft blue body background
@@ -216,11 +169,11 @@ int main(void)
                     .labelColor = { 255, 255, 255, 255 }, // prefer white labels for contrast
                     .contentAlign = RUI_ALIGN_LEFT // left aligns label within the panel
                 };
+                rui_panel_cache_next(rui_hash_string("Hello there", 0)); // static contents: re-blit one texture while unchanged
                 bool closed = rui_panel_begin_ex_closable_fade(infoPanel, "Info", false, infoStyle, infoAlpha, NULL);
                 if (closed) {
-                    infoVisible = false;
-                    infoClosing = true;
-                } else {
+                    rui_tween(infoFade, 0.0f, PANEL_FADE_TIME, RUI_EASE_OUT_QUAD);
+                } else if (!rui_panel_cache_hit()) {
                     rui_panel_label_color("Hello there", WHITE);
                 }
                 rui_panel_end();
@@ -263,15 +216,16 @@ int main(void)
             rui_panel_end();
 
             for (int i = 0; i < MAX_ITEM_PANELS; ++i) {
-                PanelFade *panel = &itemPanels[i];
-                if (!panel->visible && !panel->closing && panel->alpha <= 0.01f) continue;
+                ItemPanel *panel = &itemPanels[i];
+                float alpha = rui_tween_value(panel->fadeId, 0.0f);
+                if (!panel->visible && alpha <= 0.01f) continue;
 
                 rui_panel_style itemStyle = listStyle;
                 const char *title = panel->title[0] ? panel->title : TextFormat("Item %d", panel->itemIndex);
-                bool closed = rui_panel_begin_ex_closable_fade(panel->bounds, title, false, itemStyle, panel->alpha, NULL);
+                bool closed = rui_panel_begin_ex_closable_fade(panel->bounds, title, false, itemStyle, alpha, NULL);
                 if (closed) {
                     panel->visible = false;
-                    panel->closing = true;
+                    rui_tween(panel->fadeId, 0.0f, PANEL_FADE_TIME, RUI_EASE_OUT_QUAD);
                 }
 
                 rui_panel_spacer(6.0f);
@@ -294,12 +248,19 @@ int main(void)
                 rui_panel_end();
             }
 
+            rui_draw_popups(); // combo popups stay on top of the panels
             rui_draw_fade();
 
+            // Let EndDrawing sleep until the next input event while nothing animates
+            bool demoAnimating = IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_UP) || IsKeyDown(KEY_DOWN);
+            if (!demoAnimating && rui_next_wakeup() < 0.0) EnableEventWaiting(); // caret blink, fades and panel tweens keep polling
+            else DisableEventWaiting();
+
         EndDrawing();
     }
 
     // Cleanup
+    rui_panel_cache_clear();
     if (ui.texture.id != 0) UnloadFont(ui);
     if (emojiFont.texture.id != 0) UnloadFont(emojiFont);
     CloseWindow();
@@ -19,7 +19,27 @@
 
 #include "raylib.h" // pull in core raylib drawing/input API
 #include "raymath.h"   // for Clamp() helper function
+#include "rlgl.h" // separate alpha blend factors for panel cache captures
 #include <math.h> // for fmodf used in caret blinking
+#include <stdlib.h> // realloc/free behind RUI_REALLOC/RUI_FREE
+#include <string.h> // memcpy/strlen for recorded text
+#include <stddef.h> // offsetof for RUI_FIELD
+#ifdef RUI_THREADS
+#include <pthread.h> // worker pool for parallel panel jobs (opt-in)
+#endif
+
+#if defined(_MSC_VER) // minimal atomics for lock-free handoff between threads
+#include <intrin.h>
+#define RUI_ATOMIC_LOAD(ptr) _InterlockedOr((long volatile *)(ptr), 0)
+#define RUI_ATOMIC_STORE(ptr, value) _InterlockedExchange((long volatile *)(ptr), (long)(value))
+#define RUI_ATOMIC_EXCHANGE(ptr, value) _InterlockedExchange((long volatile *)(ptr), (long)(value))
+#define RUI_ATOMIC_ADD(ptr, value) (_InterlockedExchangeAdd((long volatile *)(ptr), (long)(value)) + (long)(value))
+#else
+#define RUI_ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define RUI_ATOMIC_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define RUI_ATOMIC_EXCHANGE(ptr, value) __atomic_exchange_n((ptr), (value), __ATOMIC_ACQ_REL)
+#define RUI_ATOMIC_ADD(ptr, value) __atomic_add_fetch((ptr), (value), __ATOMIC_ACQ_REL)
+#endif
 
 typedef struct rui_text_input { // state for single-line text input
     char *buffer; // pointer to caller-provided character buffer
@@ -93,6 +113,35 @@ typedef struct rui_theme { // aggregate theme configuration
     rui_font_style titleFont; // panel title font
 } rui_theme;
 
+typedef struct rui_metrics { // pixel sizes for one UI scale, rebuilt only when the scale or the theme changes
+    float scale; // scale these metrics were built for
+    float padding; // panel inner padding
+    float spacing; // gap between auto-layout widgets
+    float headerPadding; // title bar padding around the title text
+    float minHeaderHeight; // smallest panel header
+    float border; // widget outline thickness
+    float hairline; // title bar separator thickness
+    float scrollbarWidth; // space reserved for the scrollbar
+    float scrollbarThumb; // scrollbar thumb width
+    float scrollbarInset; // thumb distance from the panel's right edge
+    float scrollStep; // pixels scrolled per wheel notch
+    float knobSize; // slider knob
+    float trackHeight; // slider track
+    float closeButton; // title bar close button
+    float textInset; // text box padding left of the text
+    float caretWidth; // text box caret
+    float toggleGap; // space between toggle box and label
+    float toggleInset; // fill inset inside the toggle box
+    float minToggleHeight; // smallest panel toggle
+    float togglePadding; // vertical room a panel toggle adds around its label
+    rui_font_style textFont; // theme text font at the scaled pixel size (atlas from the font provider when set)
+    rui_font_style titleFont; // theme title font at the scaled pixel size
+    unsigned int textFontKey; // theme font + pixel size textFont was resolved from
+    unsigned int titleFontKey; // theme font + pixel size titleFont was resolved from
+    bool textFontBaked; // textFont.font came from the font provider and is handed to the release hook when replaced
+    bool titleFontBaked; // same for titleFont.font
+} rui_metrics;
+
 // --- API ---
 void rui_begin_frame(void); // prepare UI input state for the frame
 void rui_label(const char *text, Vector2 pos); // draw a basic label at a position
@@ -104,6 +153,7 @@ void rui_fade_out(float duration); // start fade to opaque overlay
 void rui_fade_in(float duration); // start fade to transparent overlay
 bool rui_fade_active(void); // report if fade animation currently running
 void rui_draw_fade(void); // draw overlay if fade alpha > 0
+void rui_draw_popups(void); // draw this frame's popups (combo lists) on top; call after the UI, before rui_draw_fade
 float rui_slider(Rectangle bounds, float value, float minValue, float maxValue); // horizontal slider control
 float rui_slider_call(Rectangle bounds, float value, float minValue, float maxValue, void (*callback)(float, void *), void *userData); // slider that notifies callback
 bool rui_toggle(Rectangle bounds, bool value, const char *label); // checkbox-style toggle
@@ -113,101 +163,59 @@ bool rui_text_input_box(Rectangle bounds, rui_text_input *input); // draw text b
 bool rui_keyboard_captured(void); // true when UI currently owns keyboard focus
 rui_theme rui_theme_default(void); // fetch library default theme values
 void rui_theme_set(const rui_theme *theme); // replace global theme with custom settings
-const rui_theme *rui_theme_get(void); // get pointer to current theme
+const rui_theme *rui_theme_get(void); // get pointer to current theme (shared; valid until this context's theme or scale changes)
 void rui_theme_reset(void); // restore theme to defaults
+void rui_set_scale(float scale); // UI scale of the current context (1 = sizes as written); metrics and fonts are rebuilt once
+float rui_get_scale(void); // current context's UI scale
+const rui_metrics *rui_get_metrics(void); // scaled sizes and fonts, for custom widgets matching the built-in ones
+void rui_set_font_provider(Font (*provider)(const rui_font_style *style, int pixelSize, void *userData), void *userData); // return a font baked at pixelSize (or a zero font to scale style->font)
+void rui_set_font_release(void (*release)(Font font, void *userData)); // called with every provider font once metrics stop using it (same userData)
 void rui_set_default_panel_style(rui_panel_style style); // override default panel style
 rui_panel_style rui_get_default_panel_style(void); // read current default panel style
 
-static const rui_theme RUI_THEME_DEFAULT = {
-    .panel = {
-        .bodyColor = {240, 240, 240, 255},
-        .titleColor = {200, 200, 200, 255},
-        .borderColor = {80, 80, 80, 255},
-        .titleTextColor = {0, 0, 0, 255},
-        .labelColor = {64, 64, 64, 255},
-        .contentAlign = RUI_ALIGN_LEFT
-    },
-    .button = {
-        .normal = {200, 200, 200, 255},
-        .hover = {180, 180, 220, 255},
-        .pressed = {160, 160, 200, 255},
-        .border = {80, 80, 80, 255},
-        .text = {0, 0, 0, 255}
-    },
-    .slider = {
-        .track = {180, 180, 180, 255},
-        .knob = {140, 140, 180, 255},
-        .knobHover = {160, 160, 220, 255},
-        .knobDrag = {120, 120, 200, 255}
-    },
-    .toggle = {
-        .border = {100, 100, 100, 255},
-        .borderHover = {60, 60, 60, 255},
-        .fill = {230, 230, 230, 255},
-        .fillActive = {120, 170, 220, 255},
-        .label = {80, 80, 80, 255}
-    },
-    .textInput = {
-        .background = {245, 245, 245, 255},
-        .border = {110, 110, 140, 255},
-        .borderHover = {140, 140, 160, 255},
-        .borderActive = {80, 120, 200, 255},
-        .text = {70, 70, 90, 255},
-        .caret = {80, 80, 120, 255}
-    },
-    .textFont = {0},
-    .titleFont = {0}
-};
+#define RUI_PANEL_STYLE_DEFAULT_INIT { /* library panel colours; shared by the theme, the default style and fresh layouts */ \
+    .bodyColor = {240, 240, 240, 255}, \
+    .titleColor = {200, 200, 200, 255}, \
+    .borderColor = {80, 80, 80, 255}, \
+    .titleTextColor = {0, 0, 0, 255}, \
+    .labelColor = {64, 64, 64, 255}, \
+    .contentAlign = RUI_ALIGN_LEFT \
+}
 
-static rui_theme rui_themeCurrent = {
-    .panel = {
-        .bodyColor = {240, 240, 240, 255},
-        .titleColor = {200, 200, 200, 255},
-        .borderColor = {80, 80, 80, 255},
-        .titleTextColor = {0, 0, 0, 255},
-        .labelColor = {64, 64, 64, 255},
-        .contentAlign = RUI_ALIGN_LEFT
-    },
-    .button = {
-        .normal = {200, 200, 200, 255},
-        .hover = {180, 180, 220, 255},
-        .pressed = {160, 160, 200, 255},
-        .border = {80, 80, 80, 255},
-        .text = {0, 0, 0, 255}
-    },
-    .slider = {
-        .track = {180, 180, 180, 255},
-        .knob = {140, 140, 180, 255},
-        .knobHover = {160, 160, 220, 255},
-        .knobDrag = {120, 120, 200, 255}
-    },
-    .toggle = {
-        .border = {100, 100, 100, 255},
-        .borderHover = {60, 60, 60, 255},
-        .fill = {230, 230, 230, 255},
-        .fillActive = {120, 170, 220, 255},
-        .label = {80, 80, 80, 255}
-    },
-    .textInput = {
-        .background = {245, 245, 245, 255},
-        .border = {110, 110, 140, 255},
-        .borderHover = {140, 140, 160, 255},
-        .borderActive = {80, 120, 200, 255},
-        .text = {70, 70, 90, 255},
-        .caret = {80, 80, 120, 255}
-    },
-    .textFont = {0},
-    .titleFont = {0}
-};
+#define RUI_THEME_DEFAULT_INIT { /* fonts stay zero: the first frame fills them from raylib's default font */ \
+    .panel = RUI_PANEL_STYLE_DEFAULT_INIT, \
+    .button = { \
+        .normal = {200, 200, 200, 255}, \
+        .hover = {180, 180, 220, 255}, \
+        .pressed = {160, 160, 200, 255}, \
+        .border = {80, 80, 80, 255}, \
+        .text = {0, 0, 0, 255} \
+    }, \
+    .slider = { \
+        .track = {180, 180, 180, 255}, \
+        .knob = {140, 140, 180, 255}, \
+        .knobHover = {160, 160, 220, 255}, \
+        .knobDrag = {120, 120, 200, 255} \
+    }, \
+    .toggle = { \
+        .border = {100, 100, 100, 255}, \
+        .borderHover = {60, 60, 60, 255}, \
+        .fill = {230, 230, 230, 255}, \
+        .fillActive = {120, 170, 220, 255}, \
+        .label = {80, 80, 80, 255} \
+    }, \
+    .textInput = { \
+        .background = {245, 245, 245, 255}, \
+        .border = {110, 110, 140, 255}, \
+        .borderHover = {140, 140, 160, 255}, \
+        .borderActive = {80, 120, 200, 255}, \
+        .text = {70, 70, 90, 255}, \
+        .caret = {80, 80, 120, 255} \
+    } \
+}
+
+static const rui_theme RUI_THEME_DEFAULT = RUI_THEME_DEFAULT_INIT;
 
-static rui_panel_style rui_panelStyleDefault = {
-    .bodyColor = {240, 240, 240, 255},
-    .titleColor = {200, 200, 200, 255},
-    .borderColor = {80, 80, 80, 255},
-    .titleTextColor = {0, 0, 0, 255},
-    .labelColor = {64, 64, 64, 255},
-    .contentAlign = RUI_ALIGN_LEFT
-};
 
 void rui_panel(Rectangle bounds, const char *title); // draw a static panel with the default style
 void rui_panel_ex(Rectangle bounds, const char *title, rui_panel_style style); // draw a static panel with explicit style
@@ -222,6 +230,9 @@ bool rui_panel_button_call(const char *text, float height, void (*callback)(void
 void rui_panel_label(const char *text); // layout-aware label using panel style
 void rui_panel_label_color(const char *text, Color color); // layout-aware label with explicit color
 void rui_panel_spacer(float height); // advance layout cursor by a vertical gap
+void rui_panel_skip(double height); // reserve off-screen content height without drawing (virtualized lists)
+double rui_panel_cursor(void); // content-space y of the next widget (0 = top of the content area)
+void rui_panel_visible_range(double *top, double *bottom); // content-space span inside the viewport
 void rui_panel_set_content_width(float width); // set desired width for upcoming widgets (0 = full width)
 float rui_panel_slider(float height, float value, float minValue, float maxValue); // slider using panel layout
 float rui_panel_slider_call(float height, float value, float minValue, float maxValue, void (*callback)(float, void *), void *userData); // panel slider with callback
@@ -234,71 +245,879 @@ bool rui_panel_begin_closable_fade(Rectangle bounds, const char *title, bool scr
 bool rui_panel_begin_ex_closable_fade(Rectangle bounds, const char *title, bool scrollable, rui_panel_style style, float alpha, const char *closeLabel); // styled closable panel with fade alpha
 void rui_panel_end(void); // finish current panel and draw scrollbar if needed
 
+// Cached panels (static contents rendered once into a RenderTexture2D)
+#ifndef RUI_PANEL_CACHE_MAX
+#define RUI_PANEL_CACHE_MAX 8 // number of panels that can hold a cached texture at once
+#endif
+void rui_panel_cache_next(unsigned int contentHash); // cache the next panel while contentHash, style and size stay the same; wrap its content in if (!rui_panel_cache_hit()) so nothing else draws over the blit
+bool rui_panel_cache_hit(void); // true while the current panel is blitted from its cache (panel widgets are skipped)
+void rui_panel_cache_clear(void); // unload every cached panel texture (call before CloseWindow)
+unsigned int rui_hash_string(const char *text, unsigned int seed); // FNV-1a helper for building content hashes
+
+// Damage tracking (screen regions that changed since the previous frame)
+#ifndef RUI_DAMAGE_MAX_WIDGETS
+#define RUI_DAMAGE_MAX_WIDGETS 512 // widgets compared per frame; extra widgets damage their own bounds
+#endif
+#ifndef RUI_DAMAGE_MAX_RECTS
+#define RUI_DAMAGE_MAX_RECTS 16 // damaged rectangles kept before neighbours are merged
+#endif
+void rui_damage_enable(bool enabled); // opt into per-widget change tracking
+Rectangle rui_damage_rect(void); // union of regions changed this frame (zero size when nothing changed); call after the UI
+int rui_damage_rects(Rectangle *out, int maxCount); // copy individual damaged rectangles, returns how many were written
+
+// Idle detection (let apps sleep while the UI is static)
+#ifndef RUI_MAX_FRAME_DELTA
+#define RUI_MAX_FRAME_DELTA 0.1f // longest time step animations take in one frame (e.g. after waiting for events)
+#endif
+bool rui_needs_redraw(void); // true when the frame just built animated, changed state, or saw hover/input changes; call after the UI (tweens, budget and async jobs count for the default context only)
+double rui_next_wakeup(void); // seconds until rui needs a frame without input (0 = now, < 0 = can sleep until input)
+
+// Tweens (pooled animations keyed by widget/panel id, all advanced in one pass per frame; default context only:
+// other contexts get the target or fallback, panel jobs may read but not start tweens)
+#ifndef RUI_TWEEN_MAX
+#define RUI_TWEEN_MAX 256 // live tweens; when full, new tweens jump straight to their target
+#endif
+#ifndef RUI_TWEEN_EXPIRE_FRAMES
+#define RUI_TWEEN_EXPIRE_FRAMES 120 // finished tweens not named for this many frames free their slot
+#endif
+
+typedef enum rui_ease {
+    RUI_EASE_LINEAR = 0,
+    RUI_EASE_IN_QUAD,
+    RUI_EASE_OUT_QUAD,
+    RUI_EASE_IN_OUT_QUAD,
+    RUI_EASE_OUT_CUBIC,
+    RUI_EASE_SPRING // critically damped spring, settles in about duration seconds; keeps velocity when retargeted
+} rui_ease;
+
+float rui_tween(unsigned int id, float target, float duration, rui_ease ease); // animate from the current value towards target (new ids start at target); returns the current value
+float rui_tween_start(unsigned int id, float from, float to, float duration, rui_ease ease); // (re)start from an explicit value
+void rui_tween_set(unsigned int id, float value); // jump without animating
+float rui_tween_value(unsigned int id, float fallback); // current value, or fallback for unknown ids
+bool rui_tween_active(unsigned int id); // still moving
+bool rui_tweens_active(void); // any tween moving (counted by rui_needs_redraw)
+void rui_tween_remove(unsigned int id); // drop a tween now (finished tweens also expire RUI_TWEEN_EXPIRE_FRAMES after their last use)
+
+// Frame budget scheduler (resumable widget work spread over frames within a fixed time slice; runs in the default
+// context's frames, and other contexts can neither submit nor see jobs)
+#ifndef RUI_BUDGET_MAX
+#define RUI_BUDGET_MAX 64 // registered jobs; when full, rui_budget_submit returns false
+#endif
+#ifndef RUI_FRAME_BUDGET_US
+#define RUI_FRAME_BUDGET_US 2000 // default microseconds of job work per frame
+#endif
+
+typedef bool (*rui_budget_fn)(void *userData); // do one small slice of work and return true once finished
+
+bool rui_budget_submit(unsigned int id, rui_budget_fn step, void *userData); // register a job (a running id just gets the new step/userData); false when full
+bool rui_budget_pending(unsigned int id); // job registered and not finished
+void rui_budget_cancel(unsigned int id); // drop a job before it finishes (e.g. its input changed)
+void rui_budget_set(int microseconds); // job time per frame; at least one step still runs so work always progresses
+int rui_budget_get(void); // current budget in microseconds
+double rui_budget_used(void); // seconds spent on jobs at the start of this frame
+bool rui_budget_active(void); // any job pending (counted by rui_needs_redraw)
+
+// Change events (when *_call widgets run their callbacks; coalesced events go through one queue after the widgets.
+// The queue belongs to the default context: widgets in panel jobs and other contexts always call back immediately)
+#ifndef RUI_CHANGE_MAX
+#define RUI_CHANGE_MAX 64 // widgets with a queued event; when full, callbacks run immediately
+#endif
+
+typedef enum rui_change_mode {
+    RUI_CHANGE_IMMEDIATE = 0, // every frame the value differs, inside the widget call
+    RUI_CHANGE_ON_RELEASE, // once the gesture ends: slider let go, text input unfocused, toggle clicked
+    RUI_CHANGE_THROTTLE, // at most once per seconds while changing, plus the final value
+    RUI_CHANGE_DEBOUNCE // once the value has stayed put for seconds (or the gesture ended)
+} rui_change_mode;
+
+void rui_change_next(rui_change_mode mode, float seconds); // policy for the next *_call widget only
+void rui_change_default(rui_change_mode mode, float seconds); // policy for *_call widgets without rui_change_next
+void rui_change_dispatch(void); // run due callbacks; rui_end_frame and the next frame's start call this
+bool rui_change_pending(void); // coalesced events still waiting
+bool rui_text_input_box_call(Rectangle bounds, rui_text_input *input, void (*callback)(const char *, void *), void *userData); // text box that reports edits through callback
+bool rui_panel_text_input_call(float height, rui_text_input *input, void (*callback)(const char *, void *), void *userData); // panel text box with callback
+
+// Undo log (widget edits kept as byte diffs in a fixed-size ring; the oldest entries make room for new ones;
+// only widgets of the default context record, never panel jobs or other contexts)
+typedef struct rui_undo_log { // caller-owned; one per editor
+    unsigned char *ring; // budget bytes of entries, each [header][old bytes][new bytes][size]
+    int budget; // ring size in bytes, never grows
+    long long start; // logical offset of the oldest entry
+    long long cursor; // end of the newest applied entry: undo walks back from here
+    long long end; // end of the newest entry: redo walks forward up to here
+    const void *open; // target whose entry is still being extended (slider drag, typing run)
+    int revision; // bumped by every record, undo and redo
+    unsigned char *scratch; // one entry being applied or merged
+    int scratchCapacity;
+    char *before; // the focused text input's text before this frame's keys
+    int beforeCapacity;
+    const rui_text_input *beforeOf; // input before belongs to
+} rui_undo_log;
+
+bool rui_undo_init(rui_undo_log *log, int budgetBytes); // allocate the ring once
+void rui_undo_free(rui_undo_log *log);
+void rui_undo_record(rui_undo_log *log); // widgets record their edits into log from now on (NULL stops recording)
+void rui_undo_next(void *value); // the next slider (float *) or toggle (bool *) edits *value, so its changes can be undone
+void rui_undo_break(rui_undo_log *log); // end the entry being extended: the next edit starts a new one
+bool rui_undo(rui_undo_log *log); // revert the newest applied entry; false when there is none
+bool rui_redo(rui_undo_log *log); // reapply the entry undone last; false when there is none
+bool rui_undo_available(const rui_undo_log *log);
+bool rui_redo_available(const rui_undo_log *log);
+void rui_undo_clear(rui_undo_log *log); // forget every entry (e.g. after loading another document)
+void rui_undo_forget(rui_undo_log *log, const void *memory, size_t size); // drop the entries that edit [memory, memory + size), e.g. before freeing an object
+
+// Draw lists (recorded UI frames that can be replayed or submitted later)
+typedef enum rui_draw_type { // kinds of recorded raylib calls
+    RUI_DRAW_RECT = 0, // DrawRectangleRec
+    RUI_DRAW_RECT_LINES = 1, // DrawRectangleLinesEx
+    RUI_DRAW_TEXT = 2, // DrawTextEx
+    RUI_DRAW_TEXTURE = 3, // premultiplied DrawTextureRec (cached panels)
+    RUI_DRAW_SCISSOR_BEGIN = 4, // BeginScissorMode
+    RUI_DRAW_SCISSOR_END = 5 // EndScissorMode
+} rui_draw_type;
+
+typedef struct rui_draw_command { // one recorded draw call
+    unsigned char type; // rui_draw_type
+    Color color; // final colour (alpha already applied)
+    Rectangle rect; // rectangle, scissor area, or text/texture position in x/y
+    union {
+        float thickness; // outline thickness
+        struct { int font; float size; float spacing; int offset; } text; // font slot, size, spacing, offset into text storage
+        struct { Texture2D texture; Rectangle source; } texture; // texture and source rectangle
+    } as;
+} rui_draw_command;
+
+typedef struct rui_draw_patch { // replay-time fix-up so hover and caret stay live between rebuilds
+    int command; // command whose colour is patched
+    Rectangle hot; // hover area (unused for carets)
+    Color normal; // colour when not hovered / caret hidden
+    Color hover; // colour when hovered / caret shown
+    rui_text_input *input; // caret owner, NULL for hover patches
+} rui_draw_patch;
+
+typedef struct rui_draw_list { // growable command buffer plus the strings and fonts it references
+    rui_draw_command *commands; // recorded commands in submission order
+    int commandCount; // commands in use
+    int commandCapacity; // commands allocated
+    char *text; // null-terminated strings referenced by text commands
+    int textSize; // bytes in use
+    int textCapacity; // bytes allocated
+    Font *fonts; // fonts referenced by text commands
+    int fontCount; // fonts in use
+    int fontCapacity; // fonts allocated
+    rui_draw_patch *patches; // hover/caret patches applied on replay
+    int patchCount; // patches in use
+    int patchCapacity; // patches allocated
+} rui_draw_list;
+
+void rui_draw_list_submit(const rui_draw_list *list); // issue every recorded command to raylib
+void rui_draw_list_free(rui_draw_list *list); // release memory owned by a draw list
+
+// Decoupled tick rate (rebuild widgets at a lower rate, replay the draw list in between; default context only)
+void rui_set_tick_rate(float hz); // rebuild widgets at most hz times per second (0 = every frame, frees the recorded list)
+bool rui_frame_rebuild(void); // begin a frame: true = build widgets then call rui_end_frame, false = last frame was replayed
+void rui_end_frame(void); // finish a frame started with rui_frame_rebuild or rui_begin_frame_recorded
+
+// Render-thread handoff (record on the game thread, submit on the render thread; default context only, other
+// contexts use rui_context_set_output)
+void rui_begin_frame_recorded(void); // begin a frame that only records; rui_end_frame publishes it without touching GL
+const rui_draw_list *rui_frame_acquire(void); // render thread: newest published frame (NULL before the first); valid until the next acquire
+void rui_frame_queue_free(void); // release the handoff buffers once both threads are done
+
+// Memory (every rui heap allocation goes through one hook; transient data can use the frame arena)
+#ifndef RUI_REALLOC
+#define RUI_REALLOC(ptr, size) realloc((ptr), (size)) // compile-time default allocator
+#endif
+#ifndef RUI_FREE
+#define RUI_FREE(ptr) free(ptr)
+#endif
+#ifndef RUI_FRAME_ARENA_SIZE
+#define RUI_FRAME_ARENA_SIZE (64 * 1024) // initial frame arena bytes (grows between frames to the peak seen)
+#endif
+#ifndef RUI_FRAME_ARENA_OVERFLOW
+#define RUI_FRAME_ARENA_OVERFLOW 64 // heap blocks a frame may spill into once the arena is full
+#endif
+
+typedef struct rui_allocator { // runtime allocator hooks (thread-safe if panel jobs or other threads use rui)
+    void *(*reallocate)(void *ptr, size_t size, void *userData); // like realloc; ptr may be NULL
+    void (*release)(void *ptr, void *userData); // like free; ptr may be NULL
+    void *userData; // passed to both
+} rui_allocator;
+
+typedef struct rui_alloc_stats { // counters for the frame in progress and the one before
+    int frameAllocations; // heap allocations since this frame began
+    int frameBytes; // bytes requested by those allocations
+    int lastFrameAllocations; // totals of the previous frame
+    int lastFrameBytes;
+    int totalAllocations; // since startup (wraps)
+    int refusedAllocations; // allocations refused in strict mode
+    int arenaUsed; // frame arena bytes handed out this frame
+    int arenaCapacity; // current arena size
+    int arenaPeak; // largest per-frame arena use seen
+} rui_alloc_stats;
+
+void rui_set_allocator(const rui_allocator *allocator); // NULL restores RUI_REALLOC/RUI_FREE; set before rui allocates anything
+rui_alloc_stats rui_get_alloc_stats(void); // snapshot of the counters
+void rui_set_alloc_strict(bool strict); // true: refuse every heap allocation (steady-state frames must not need any)
+void *rui_frame_alloc(int size); // 16-byte aligned scratch valid until the next rui_begin_frame; NULL on failure
+void rui_frame_arena_free(void); // release the frame arena (shutdown)
+
+// Kinetic scrolling (fixed-step integration, identical at any frame rate)
+#ifndef RUI_SCROLL_TIMESTEP
+#define RUI_SCROLL_TIMESTEP (1.0f / 240.0f) // seconds per integration step
+#endif
+#ifndef RUI_SCROLL_DAMPING
+#define RUI_SCROLL_DAMPING 10.0f // exponential velocity decay per second (higher stops sooner)
+#endif
+#ifndef RUI_SCROLL_REST_SPEED
+#define RUI_SCROLL_REST_SPEED 2.0f // px/s below which scrolling counts as settled
+#endif
+#ifndef RUI_SCROLL_FLICK_SMOOTHING
+#define RUI_SCROLL_FLICK_SMOOTHING 0.05f // seconds of scrollbar drag history averaged into the release velocity
+#endif
+#ifndef RUI_SCROLL_PANELS
+#define RUI_SCROLL_PANELS 8 // scrollable panels per layout that keep their own position (least recently drawn is reset)
+#endif
+
+typedef struct rui_panel_scroll { // one scrollable panel's scroll state between frames, found by its title hash
+    unsigned int id; // panelId of the owner
+    unsigned int used; // layout's scrollTick when the panel last began (0 = free)
+    double offset;
+    double prevContentHeight;
+    bool hasPrevContent;
+    bool dragging; // thumb held
+    float dragOffsetY;
+    float velocity;
+    float accumulator;
+} rui_panel_scroll;
+
+// Layout state (everything a panel build writes; one per thread/panel job instead of process-wide globals)
+#if defined(_MSC_VER)
+#define RUI_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define RUI_THREAD_LOCAL _Thread_local
+#else
+#define RUI_THREAD_LOCAL __thread // GCC/Clang extension, also available in C99 mode
+#endif
+
+typedef struct rui_layout_state { // per-build panel layout, scroll, alpha and interaction state
+    // Panel layout
+    Rectangle currentPanel; // rectangle describing active panel
+    unsigned int panelId; // hash of the active panel's title (stable while it moves or scrolls)
+    double panelCursorY; // content-space y of the next auto-layout widget (0 = top of the content area)
+    float panelPadding; // horizontal padding inside panels
+    float panelSpacing; // vertical spacing between widgets
+    float panelHeaderHeight; // active panel header height
+    float panelInnerLeft; // cached inner left edge for content placement
+    float panelInnerRight; // cached inner right edge for content placement
+    float panelContentWidth; // target width for auto-layout widgets
+    rui_panel_style currentPanelStyle; // active style for panel-driven widgets
+    bool panelActive; // flag to guard panel-only calls
+    bool panelHasTitle; // indicates current panel has a title bar
+    bool panelCloseRequested; // flag indicating we want to draw a close button
+    bool panelClosePressed; // remembers if close button was clicked this frame
+    const char *panelCloseLabel; // optional custom label for close button
+    // Scroll
+    bool panelScrollable; // panel scrolling enabled flag
+    bool hasPrevContent; // tracks if previous height is valid
+    bool draggingScrollbar; // true while thumb is being dragged
+    double scrollOffset; // current scroll offset in pixels (double: content can exceed float precision)
+    double contentHeight; // height consumed by widgets this frame
+    double prevContentHeight; // previous frame's content height
+    float dragOffsetY; // mouse-to-thumb offset during drag
+    float scrollVelocity; // kinetic scroll speed in px/s (wheel impulses and flicks), 0 when settled
+    float scrollAccumulator; // time not yet consumed by fixed scroll steps
+    double scrollOffsetBeforePanel; // backup scroll offset before panel begins
+    rui_panel_scroll scrollPanels[RUI_SCROLL_PANELS]; // per-panel copies of the fields above, swapped in and out by scrollable panels
+    int scrollSlot; // entry the active scrollable panel loaded
+    unsigned int scrollTick; // scrollable panel begins, ages the entries
+    // Alpha stack
+    float alphaStack[8]; // alpha stack for nested fades
+    int alphaTop; // alpha stack index
+    float alphaCurrent; // current multiplied alpha
+    bool panelAlphaApplied; // true when current panel pushed alpha
+    // Panel cache
+    bool panelCacheRequested; // set by rui_panel_cache_next for the next panel begin
+    bool panelCacheHit; // active panel is served from its texture
+    bool panelCacheCapturing; // active panel is being rendered into its texture
+    bool panelCacheDirty; // widgets holding focus/drag state veto the capture
+    unsigned int panelCacheHash; // content hash requested for the next panel
+    struct rui_panel_cache_entry *panelCacheEntry; // cache entry used by the active panel
+    Vector2 drawOrigin; // screen offset removed from scissor rects while capturing
+    // Interaction
+    bool activity; // something changed or is being dragged this frame
+    bool sliderDragging; // a slider knob is held
+    Rectangle activeSlider; // bounds of the slider being dragged
+    bool sliderHeld; // the slider drawn last is the one being dragged (gesture still in progress)
+    unsigned int hoverHash; // hover states of this frame's widgets in call order
+    unsigned int hoverHashPrev; // hover hash of the previous frame
+    // Draw output
+    rui_draw_list *drawRecordTarget; // list receiving commands (NULL = not recording)
+    bool drawExecute; // issue raylib calls while widgets run
+} rui_layout_state;
+
+void rui_layout_init(rui_layout_state *layout); // reset a layout state to library defaults
+
+// Contexts (independent UI instances: own input, focus, fade and layout, and a pointer to a skin shared by contexts
+// with the same theme and scale; no allocation. Tweens, budget jobs, change events, undo recording, panel caching,
+// damage and tick-rate replay are process-wide and belong to the default context)
+#ifndef RUI_SKIN_MAX
+#define RUI_SKIN_MAX 16 // distinct theme + scale pairs in use at once; when full, theme and scale changes keep the current look
+#endif
+typedef struct rui_context { // everything one UI instance reads and writes while building
+    Vector2 mouse; // mouse position captured each frame (after the input transform)
+    bool mousePressed; // true if mouse button pressed this frame
+    bool keyboardCaptured; // true when this context's text box has keyboard focus
+    bool fadeActive; // true while fade animation runs
+    float frameDelta; // clamped frame time used by rui animations
+    rui_text_input *activeTextInput; // currently focused text input box
+    Vector2 inputOffset; // subtracted from the raw mouse position ...
+    Vector2 inputScale; // ... then multiplied by this (zero = 1)
+    Vector2 pointer; // explicit pointer position (surfaces), used instead of the window mouse when pointerOverride is set
+    bool pointerOverride; // take input from pointer instead of GetMousePosition
+    bool pointerInside; // pointer currently hits this context's surface (clicks are ignored otherwise)
+    float pendingDelta; // time from skipped frames, added to the next frame's delta
+    bool popupPressed; // click as seen by popups (widgets underneath a popup get none)
+    Vector2 popupMouse; // mouse as seen by popups
+    Rectangle popupRect; // area covered by popups drawn this frame
+    Rectangle popupRectPrev; // popups of the previous frame; the mouse over them is hidden from other widgets
+    struct rui_combo *activeCombo; // open combo box (owns keyboard focus)
+    bool activeComboDrawn; // activeCombo's widget ran since the last rebuild began
+    float fadeAlpha; // current overlay alpha 0-255
+    float fadeStartAlpha; // starting alpha for current fade
+    float fadeTargetAlpha; // target alpha to reach at end of fade
+    float fadeDuration; // total animation time in seconds
+    float fadeElapsed; // elapsed time since fade start
+    Color fadeColor; // overlay color (alpha overridden per frame)
+    float scale; // requested UI scale (metrics.scale lags until the next rebuild)
+    struct rui_context *previous; // context restored by rui_end_frame_ctx
+    rui_draw_list *output; // when set, frames record here instead of drawing (for contexts built off the GL thread)
+    rui_draw_list *popups; // popup commands of this frame, drawn last by rui_draw_popups (allocated by the first popup)
+    struct rui_skin *skin; // theme and scaled metrics, shared with every context using the same theme and scale (NULL until the first frame)
+    rui_panel_style panelStyleDefault; // style used by rui_panel/rui_panel_begin
+    rui_layout_state layout; // panel layout, scroll, alpha stack and drag state (largest, kept last)
+} rui_context;
+
+void rui_context_init(rui_context *ctx); // reset a context to library defaults (theme is resolved on its first frame)
+void rui_context_free(rui_context *ctx); // release buffers the context grew (popup commands) and its share of the skin
+rui_context *rui_context_default(void); // the context used by the plain API
+rui_context *rui_context_set(rui_context *ctx); // make ctx current on this thread (NULL = default), returns the previous one
+rui_context *rui_context_get(void); // context current on this thread
+void rui_context_set_input_transform(rui_context *ctx, Vector2 offset, Vector2 scale); // map window mouse coordinates into the context's space
+void rui_context_set_output(rui_context *ctx, rui_draw_list *list); // record ctx's frames into list (NULL = draw immediately)
+void rui_begin_frame_ctx(rui_context *ctx); // make ctx current and begin its frame
+void rui_end_frame_ctx(rui_context *ctx); // end ctx's frame and restore the context that was current before
+void rui_theme_set_ctx(rui_context *ctx, const rui_theme *theme); // replace one context's theme
+bool rui_keyboard_captured_ctx(const rui_context *ctx); // true when ctx owns keyboard focus
+
+// Surfaces (UI rendered into a RenderTexture2D, e.g. in-world screens)
+typedef enum rui_surface_policy {
+    RUI_SURFACE_EVERY_FRAME = 0, // rebuild and redraw every frame
+    RUI_SURFACE_EVERY_N, // every interval-th frame, or sooner when pointed at
+    RUI_SURFACE_ON_CHANGE // only when pointed at, animating, focused or marked dirty
+} rui_surface_policy;
+
+typedef struct rui_surface { // texture, UI context and update bookkeeping for one surface
+    rui_context context; // the surface's own focus, scroll, theme and input
+    RenderTexture2D target; // what the UI is drawn into (sample it with a flipped source rect)
+    rui_surface_policy policy; // when rui_surface_begin actually updates
+    int interval; // frames between updates for RUI_SURFACE_EVERY_N
+    int framesSkipped; // frames since the last update
+    bool visible; // false skips every update (off-screen or too distant); true after init
+    bool dirty; // force one update (app data shown on the surface changed)
+    bool wantsUpdate; // the last update animated or left hover/focus state that must be refreshed
+    bool updating; // between a true rui_surface_begin and rui_surface_end
+    Vector2 pointerPrev; // pointer at the last update, to detect movement
+    bool pointerInsidePrev; // pointer hit the surface at the last update
+} rui_surface;
+
+void rui_surface_init(rui_surface *surface, int width, int height); // load the texture and a fresh context (every-frame policy)
+void rui_surface_unload(rui_surface *surface); // release the texture
+void rui_surface_set_policy(rui_surface *surface, rui_surface_policy policy, int interval); // choose when the surface redraws
+void rui_surface_set_pointer(rui_surface *surface, Vector2 texel, bool inside); // pointer in texture pixels for the next update
+bool rui_surface_pointer_from_ray(rui_surface *surface, Ray ray, Vector3 topLeft, Vector3 topRight, Vector3 bottomRight, Vector3 bottomLeft); // map a mouse ray onto a world-space quad; true on hit
+bool rui_surface_begin(rui_surface *surface); // false when this frame is skipped (texture keeps its contents); call before BeginDrawing
+void rui_surface_end(rui_surface *surface); // finish an update started by a true rui_surface_begin
+
+// Parallel panel construction (build independent panels on worker threads, merge in z order)
+#ifndef RUI_WORKER_COUNT
+#define RUI_WORKER_COUNT 3 // worker threads started with RUI_THREADS (the calling thread helps too)
+#endif
+#ifndef RUI_TASK_QUEUE_SIZE
+#define RUI_TASK_QUEUE_SIZE 256 // pending tasks before frame work runs inline (async jobs wait for room instead)
+#endif
+
+typedef struct rui_panel_job { // one independent panel (or group of panels) built off the main thread
+    void (*build)(void *userData); // issues rui_panel_begin ... rui_panel_end calls
+    void *userData; // passed to build
+    struct rui_context *context; // context the job was run from (set by rui_panel_jobs_run)
+    int z; // merge order: lower z is drawn first, ties keep array order
+    rui_layout_state layout; // the job's own layout/scroll state, kept across frames
+    rui_draw_list commands; // commands recorded by the last run
+} rui_panel_job;
+
+void rui_panel_job_init(rui_panel_job *job, void (*build)(void *userData), void *userData, int z); // set up a job once
+void rui_panel_jobs_run(rui_panel_job *jobs, int count); // build all jobs (in parallel with RUI_THREADS) and draw/record them in z order
+void rui_panel_job_free(rui_panel_job *job); // release the job's command buffer
+void rui_workers_shutdown(void); // stop worker threads (no-op without RUI_THREADS)
+
+// Async callbacks (slow handlers run on the worker pool; the widget shows a busy state until they finish)
+typedef struct rui_job { // one callback handed to the pool; zero-initialise and keep alive while busy
+    void (*callback)(void *userData); // runs on a worker (inline without RUI_THREADS)
+    void *userData; // passed to callback and done
+    void (*done)(void *userData); // optional: runs on the UI thread in rui_begin_frame once callback returned
+    int state; // 0 idle, 1 running, 2 finished but not yet polled (written by the worker), 3 waiting for room in the task queue
+    int runs; // completed runs
+    unsigned int doneFrame; // frame in which the last run was polled
+    struct rui_job *next; // running jobs, polled by rui_begin_frame
+} rui_job;
+
+bool rui_job_start(rui_job *job, void (*callback)(void *), void *userData); // false (and nothing queued) while the job is still busy
+bool rui_job_busy(const rui_job *job); // started and not yet polled as finished
+bool rui_job_done(const rui_job *job); // true during the frame in which the last run was reported finished
+int rui_jobs_poll(void); // retire finished jobs and run their done callbacks; rui_begin_frame calls this
+void rui_jobs_wait(void); // block until every started job has finished (e.g. before freeing their userData)
+bool rui_button_call_async(const char *text, Rectangle bounds, rui_job *job, void (*callback)(void *), void *userData); // button that runs callback on the pool; busy until it returns
+bool rui_panel_button_call_async(const char *text, float height, rui_job *job, void (*callback)(void *), void *userData); // panel button with pooled callback
+
+// Selection sets (indices kept as sorted runs, so ranges and select-all cost O(runs) however many rows they cover)
+typedef struct rui_selection { // selected indices as sorted, non-touching [start, end) runs
+    long *runs; // start/end pairs
+    int runCount; // pairs in runs
+    int capacity; // pairs allocated
+    long count; // selected indices
+    long anchor; // index shift-click ranges start from, -1 for none
+    int hint; // run rui_selection_contains checks first, so in-order queries stay O(1)
+    unsigned int revision; // bumped on every change (for content hashes)
+} rui_selection;
+
+void rui_selection_init(rui_selection *selection); // empty, no anchor
+void rui_selection_free(rui_selection *selection);
+void rui_selection_clear(rui_selection *selection);
+void rui_selection_all(rui_selection *selection, long count); // select 0 .. count - 1 as one run
+void rui_selection_set(rui_selection *selection, long start, long end, bool selected); // select or deselect [start, end)
+void rui_selection_toggle(rui_selection *selection, long index);
+bool rui_selection_contains(rui_selection *selection, long index);
+long rui_selection_next(const rui_selection *selection, long from); // first selected index >= from, -1 when none
+void rui_selection_click(rui_selection *selection, long index, bool extend, bool toggle); // list click: plain replaces, toggle (ctrl) flips, extend (shift) selects from the anchor
+
+// Tables (virtualized rows and columns inside a scrollable panel; cells are pulled only while visible)
+typedef const char *(*rui_table_cell_fn)(long row, int column, char *buffer, int bufferSize, void *userData); // return the cell text, or format a value into buffer and return it
+
+typedef struct rui_table_column { // one column, owned by the caller
+    const char *title; // header text
+    float width; // current width in pixels (updated when the user drags the header edge)
+    float minWidth; // narrowest the user can drag it (0 = a few text insets)
+} rui_table_column;
+
+typedef struct rui_table { // table description plus interaction state kept across frames
+    rui_table_column *columns; // caller-owned column array
+    int columnCount; // number of columns
+    long rowCount; // number of data rows (the header is extra)
+    float rowHeight; // row and header height (0 = from the text font)
+    bool stickyFirstColumn; // first column stays put while scrolling horizontally
+    rui_table_cell_fn cell; // text for one cell, called only for visible cells
+    void *userData; // passed to cell
+    float scrollX; // horizontal scroll of the non-sticky columns
+    long selectedRow; // last clicked row, -1 for none
+    rui_selection *selection; // optional multi-select (ctrl/shift click, ctrl+A over the rows); NULL = single selection
+    long hoveredRow; // row under the cursor this frame, -1 for none
+    int resizingColumn; // column whose edge is being dragged, -1 when idle
+    float resizeAnchor; // cursor x minus column width when the drag started
+    bool draggingBar; // horizontal scrollbar thumb is held
+    float barGrab; // cursor-to-thumb offset while held
+} rui_table;
+
+void rui_table_init(rui_table *table, rui_table_column *columns, int columnCount, long rowCount, rui_table_cell_fn cell, void *userData); // describe a table once
+long rui_panel_table(rui_table *table); // lay the table out in the active panel; returns the clicked row or -1
+
+// Background sort & filter (permutation index built on the worker pool, swapped in when complete)
+#ifndef RUI_SORT_CHUNK
+#define RUI_SORT_CHUNK 16384 // rows per worker task when filtering, sorting and merging
+#endif
+
+typedef bool (*rui_filter_fn)(long row, void *userData); // true keeps the row; runs on worker threads
+typedef double (*rui_sort_number_fn)(long row, void *userData); // numeric sort key; runs on worker threads
+typedef const char *(*rui_sort_text_fn)(long row, void *userData); // string sort key, must stay valid until the job finishes
+
+typedef struct rui_sort_request { // what to compute; callbacks may only read app data, from several threads at once
+    long rowCount; // rows in the app's data
+    rui_filter_fn filter; // NULL keeps every row
+    rui_sort_number_fn number; // radix-sorted numeric key (takes precedence over text)
+    rui_sort_text_fn text; // merge-sorted string key; neither key keeps the data order
+    bool descending; // reverse the key order (ties stay in row order)
+    void *userData; // passed to every callback
+} rui_sort_request;
+
+typedef struct rui_sort_view { // display order for a list or table, rebuilt in the background
+    long *order; // display index -> data row, NULL until the first result (read on the UI thread only)
+    long count; // rows in order
+    rui_sort_request active; // request the workers are running
+    rui_sort_request next; // latest request made while busy, started when the running one ends
+    bool hasNext; // next is waiting
+    bool busy; // a job is running (UI thread view)
+    int ready; // 1 = back holds a finished index, 2 = the job was cancelled (atomic)
+    int cancel; // asks the running job to stop early (atomic)
+    int unitsDone; // finished work units, for progress (atomic)
+    int unitsTotal; // work units in the running job (atomic)
+    bool deferred; // the task queue was full: rui_sort_view_poll submits the job
+    long *back; // index being built by the workers
+    long backCount; // rows in back
+    struct rui_sort_item *items; // key/row pairs being sorted
+    struct rui_sort_item *scratch; // ping-pong buffer for radix passes and merges
+    struct rui_sort_chunk *chunks; // per-task slices
+    long capacity; // rows the buffers can hold
+} rui_sort_view;
+
+void rui_sort_view_init(rui_sort_view *view); // empty view (identity order until the first result)
+void rui_sort_view_request(rui_sort_view *view, const rui_sort_request *request); // start a job, or replace the one queued behind the running job
+bool rui_sort_view_poll(rui_sort_view *view); // once per frame: swap in a finished index; true when the order changed
+bool rui_sort_view_busy(const rui_sort_view *view); // a job is running or queued
+float rui_sort_view_progress(const rui_sort_view *view); // 0-1 progress of the running job (1 when idle)
+long rui_sort_view_count(const rui_sort_view *view, long rowCount); // rows to display (rowCount until the first result)
+long rui_sort_view_row(const rui_sort_view *view, long index); // data row shown at a display index
+void rui_sort_view_free(rui_sort_view *view); // stop the running job and release the buffers
+
+// Tree view (children fetched on expand; visible rows kept in a flat gap buffer, drawn virtualized)
+typedef unsigned long long rui_tree_id; // app node handle (index, key or pointer)
+typedef long (*rui_tree_children_fn)(rui_tree_id node, rui_tree_id *out, long capacity, void *userData); // write up to capacity child ids, return the child count (out is NULL to ask for the count)
+typedef bool (*rui_tree_has_children_fn)(rui_tree_id node, void *userData); // cheap "can expand" test
+typedef const char *(*rui_tree_label_fn)(rui_tree_id node, char *buffer, int bufferSize, void *userData); // row text (own string, or formatted into buffer)
+
+typedef struct rui_tree_row { // one visible row
+    rui_tree_id id; // node
+    int depth; // 0 for children of the root
+    bool hasChildren; // draws an expander
+    bool expanded; // children are the rows that follow
+} rui_tree_row;
+
+typedef struct rui_tree { // tree description, flattened visible rows and interaction state
+    rui_tree_id root; // node whose children are the top-level rows (not drawn)
+    rui_tree_children_fn children; // called once per expand
+    rui_tree_has_children_fn hasChildren; // NULL = every node may have children
+    rui_tree_label_fn label; // called for visible rows only
+    void *userData; // passed to the callbacks
+    float rowHeight; // 0 = from the text font
+    long count; // visible rows
+    rui_tree_id selected; // last clicked node
+    bool hasSelection; // selected is valid
+    long hoveredRow; // row under the cursor this frame, -1 for none
+    rui_tree_row *rows; // gap buffer: rows [0, gapStart) then a gap then the rest
+    long capacity; // slots in rows
+    long gapStart; // logical index where the gap sits (last edit position)
+    rui_tree_id *scratch; // child ids fetched during an expand
+    long scratchCapacity; // ids scratch can hold
+} rui_tree;
+
+bool rui_tree_init(rui_tree *tree, rui_tree_id root, rui_tree_children_fn children, rui_tree_has_children_fn hasChildren, rui_tree_label_fn label, void *userData); // load the top-level rows
+void rui_tree_reload(rui_tree *tree); // collapse everything and fetch the top level again (hierarchy changed)
+bool rui_tree_toggle(rui_tree *tree, long row); // expand or collapse a visible row; false when it cannot expand
+const rui_tree_row *rui_tree_row_at(const rui_tree *tree, long row); // visible row, NULL when out of range
+void rui_tree_free(rui_tree *tree); // release the row and scratch buffers
+long rui_panel_tree(rui_tree *tree); // lay the tree out in the active panel; returns the clicked row or -1
+
+// Combo box (virtualized popup list on top of everything, type-ahead through a sorted prefix index)
+#ifndef RUI_TYPEAHEAD_TIMEOUT
+#define RUI_TYPEAHEAD_TIMEOUT 1.0 // seconds between keys before type-ahead starts a new prefix
+#endif
+
+typedef const char *(*rui_item_fn)(long index, char *buffer, int bufferSize, void *userData); // item text (own string, or formatted into buffer)
+
+typedef struct rui_combo { // item source, selection and popup state
+    long itemCount; // items in the source
+    rui_item_fn item; // text for one item, called only for visible rows (and once per item to build the index)
+    void *userData; // passed to item
+    long selected; // chosen item, -1 for none
+    bool open; // popup showing
+    int visibleRows; // popup height in rows (0 = 8)
+    long highlighted; // item under the keyboard cursor in the popup
+    double scroll; // popup scroll offset in pixels
+    char typed[32]; // type-ahead prefix
+    int typedLength; // characters in typed
+    double typedTime; // GetTime() of the last type-ahead key
+    long typedPosition; // position of the last match in index
+    long *index; // item indices sorted by text (case-insensitive), NULL until first needed
+    char *labels; // item texts copied for the index
+    long *labelOffsets; // start of each item's text in labels
+} rui_combo;
+
+void rui_combo_init(rui_combo *combo, long itemCount, rui_item_fn item, void *userData); // nothing selected, popup closed
+void rui_combo_set_items(rui_combo *combo, long itemCount, rui_item_fn item, void *userData); // new item source (drops the type-ahead index)
+bool rui_combo_box(rui_combo *combo, Rectangle bounds); // draw the box (and popup when open); true when the selection changed
+bool rui_panel_combo(rui_combo *combo, float height); // combo box in the active panel (the popup does not move the layout cursor)
+void rui_combo_free(rui_combo *combo); // release the type-ahead index
+
+// Command palette (fuzzy subsequence search over a large item list, results in a virtualized popup)
+#ifndef RUI_PALETTE_SCORE_LEVELS
+#define RUI_PALETTE_SCORE_LEVELS 2048 // distinct match scores; results are bucket-sorted by score
+#endif
+
+typedef struct rui_palette { // item source, query and ranked results
+    long itemCount; // items in the source
+    rui_item_fn item; // text for one item (read once into the match index, then only for visible rows)
+    void *userData; // passed to item
+    bool open; // popup showing
+    int visibleRows; // result rows shown at once (0 = 10)
+    float width; // popup width (0 = 60% of the screen)
+    long chosen; // item picked by the last Enter or click, -1 for none
+    long highlighted; // result position under the keyboard cursor
+    double scroll; // result list scroll offset in pixels
+    char query[128]; // typed text, edited through input
+    rui_text_input input; // query box
+    char matched[128]; // folded query the results belong to
+    bool matchedValid; // results are current for matched
+    long *candidates; // matching items in item order
+    int *scores; // score of each candidate
+    long *results; // matching items, best first
+    long resultCount; // entries in candidates, scores and results
+    char *labels; // folded item texts, NULL until the palette first opens
+    long *labelOffsets; // start of each item's text in labels
+    unsigned long long *masks; // characters present in each item, for rejecting non-matches without scanning
+} rui_palette;
+
+void rui_palette_init(rui_palette *palette, long itemCount, rui_item_fn item, void *userData); // closed, empty query
+void rui_palette_set_items(rui_palette *palette, long itemCount, rui_item_fn item, void *userData); // new item source (drops the match index)
+void rui_palette_open(rui_palette *palette); // show with an empty query and keyboard focus
+void rui_palette_close(rui_palette *palette);
+bool rui_command_palette(rui_palette *palette); // call once per frame; true when an item was chosen (palette->chosen)
+void rui_palette_free(rui_palette *palette); // release the match index and result buffers
+
+// Property grid (one row per described struct member; edits are found by comparing a packed snapshot)
+typedef enum rui_field_type {
+    RUI_FIELD_FLOAT = 0, // float or double (by size, 4 or 8)
+    RUI_FIELD_INT, // 1, 2, 4 or 8 byte signed integer (by size)
+    RUI_FIELD_BOOL, // bool
+    RUI_FIELD_TEXT // char array edited in place (size >= 1, includes the terminator)
+} rui_field_type;
+
+typedef struct rui_field { // one editable struct member
+    const char *name; // row label
+    rui_field_type type;
+    size_t offset; // offsetof(struct, member)
+    int size; // sizeof(member)
+    float min; // slider range; max <= min shows a -/+ stepper instead
+    float max;
+    float step; // stepper increment and integer slider snapping (0 = 1)
+} rui_field;
+
+#define RUI_FIELD(type, member, kind, minValue, maxValue) { #member, kind, offsetof(type, member), (int)sizeof(((type *)0)->member), minValue, maxValue, 0.0f }
+
+typedef struct rui_property_grid { // field list plus the snapshot edits are detected against
+    const rui_field *fields; // caller-owned descriptors
+    int fieldCount;
+    float labelWidth; // name column width (0 = 40% of the row)
+    float rowHeight; // row height (0 = from the text font)
+    int *changed; // indices of the fields that changed during the last call
+    int changedCount;
+    unsigned char *snapshot; // every field's bytes after the last call, packed back to back
+    int *snapshotOffset; // start of each field in snapshot
+    const void *snapshotOf; // instance the snapshot was taken from
+    size_t instanceSize; // bytes the fields span from the start of an instance
+    rui_text_input *inputs; // edit state for text fields (indexed by field)
+} rui_property_grid;
+
+bool rui_property_grid_init(rui_property_grid *grid, const rui_field *fields, int fieldCount); // describe the grid once; false on a field size its type can't have
+int rui_panel_property_grid(rui_property_grid *grid, void *instance); // rows for instance in the active panel; returns how many fields changed (see grid->changed)
+void rui_property_grid_free(rui_property_grid *grid);
+
+// Autocomplete (text input suggestions from a trie built once from a vocabulary)
+#ifndef RUI_AUTOCOMPLETE_MAX
+#define RUI_AUTOCOMPLETE_MAX 16 // most suggestions shown at once
+#endif
+
+typedef struct rui_trie_node { // one prefix; its children are nodes first .. first + childCount - 1
+    int first; // index of the first child
+    int word; // vocabulary index of the word ending here, -1 for none
+    unsigned best; // highest frequency in this subtree
+    unsigned short childCount; // children, sorted by edge byte
+} rui_trie_node;
+
+typedef struct rui_trie { // vocabulary packed into flat arrays in breadth-first order
+    rui_trie_node *nodes; // node 0 is the empty prefix
+    unsigned char *edges; // byte leading into each node
+    int nodeCount;
+    long wordCount; // vocabulary size
+    unsigned *frequency; // per vocabulary word, copied at build time
+    rui_item_fn word; // vocabulary text, read at build time and for shown suggestions
+    void *userData; // passed to word
+    unsigned *heapKey; // best-first search queue (scratch)
+    int *heapEntry;
+    int heapCapacity;
+} rui_trie;
+
+typedef struct rui_autocomplete { // suggestion popup state for one text input
+    rui_trie *trie; // vocabulary to complete from (may be switched per frame, e.g. command vs argument)
+    int maxSuggestions; // rows shown (0 = 8, at most RUI_AUTOCOMPLETE_MAX)
+    long suggestions[RUI_AUTOCOMPLETE_MAX]; // vocabulary indices, most frequent first
+    int count; // entries in suggestions
+    int highlighted; // row Tab accepts
+    char prefix[64]; // word being completed when suggestions were fetched
+    const rui_trie *prefixTrie; // trie suggestions were fetched from
+    bool dismissed; // hidden until the word changes
+} rui_autocomplete;
+
+bool rui_trie_build(rui_trie *trie, long wordCount, rui_item_fn word, const unsigned *frequency, void *userData); // frequency may be NULL (all equal)
+int rui_trie_complete(rui_trie *trie, const char *prefix, long *out, int maxCount); // most frequent words starting with prefix, returns how many
+void rui_trie_free(rui_trie *trie);
+bool rui_text_input_box_complete(Rectangle bounds, rui_text_input *input, rui_autocomplete *complete); // text box with a suggestion popup for the word before the caret
+bool rui_panel_text_input_complete(float height, rui_text_input *input, rui_autocomplete *complete); // same, laid out in the active panel
+
 #ifdef RUI_IMPLEMENTATION // compile implementation when requested
 // --- Internal State ---
 
-// Input state
-static Vector2 rui_mouse; // mouse position captured each frame
-static bool rui_mousePressed; // true if mouse button pressed this frame
-
 // Panel layout state
-static Rectangle rui_currentPanel = {0}; // rectangle describing active panel
-static float rui_panelCursorY = 0.0f; // current y offset for auto-layout widgets
-static float rui_panelPadding = 8.0f; // horizontal padding inside panels
-static float rui_panelSpacing = 6.0f; // vertical spacing between widgets
-static bool rui_panelActive = false; // flag to guard panel-only calls
-static bool rui_panelHasTitle = false; // indicates current panel has a title bar
-static bool rui_panelCloseRequested = false; // flag indicating we want to draw a close button
-static bool rui_panelClosePressed = false; // remembers if close button was clicked this frame
-static const char *rui_panelCloseLabel = NULL; // optional custom label for close button
-static float rui_panelHeaderHeight = 24.0f; // active panel header height
-
-// Scroll state
-static bool rui_panelScrollable = false; // panel scrolling enabled flag
-static float rui_scrollOffset = 0; // current scroll offset in pixels
-static float rui_contentHeight = 0; // height consumed by widgets this frame
-static float rui_prevContentHeight = 0; // previous frame's content height
-static bool rui_hasPrevContent = false; // tracks if previous height is valid
-static bool rui_draggingScrollbar = false; // true while thumb is being dragged
-static float rui_dragOffsetY = 0; // mouse-to-thumb offset during drag
-
-static rui_panel_style rui_currentPanelStyle = { // active style for panel-driven widgets
-    .bodyColor = {240, 240, 240, 255}, // default body color
-    .titleColor = {200, 200, 200, 255}, // default title color
-    .borderColor = {80, 80, 80, 255}, // default border
-    .titleTextColor = {0, 0, 0, 255}, // default title text color
-    .labelColor = {64, 64, 64, 255}, // default label text color
-    .contentAlign = RUI_ALIGN_LEFT // default alignment state
+#define RUI_LAYOUT_DEFAULT_INIT { /* initial values for every layout state */ \
+    .panelPadding = 8.0f, /* horizontal padding inside panels */ \
+    .panelSpacing = 6.0f, /* vertical spacing between widgets */ \
+    .panelHeaderHeight = 24.0f, /* header height before the first panel computes it */ \
+    .currentPanelStyle = RUI_PANEL_STYLE_DEFAULT_INIT, \
+    .alphaStack = {1.0f}, /* base of the alpha stack is fully opaque */ \
+    .alphaCurrent = 1.0f, \
+    .drawExecute = true /* draw immediately unless recording for another thread */ \
+}
+
+static const rui_layout_state RUI_LAYOUT_DEFAULT = RUI_LAYOUT_DEFAULT_INIT; // copied by rui_layout_init and rui_context_init
+static rui_context rui_contextDefault = { // context behind the plain API; also owns cache, damage, tick rate and handoff (same defaults as rui_context_init)
+    .layout = RUI_LAYOUT_DEFAULT_INIT,
+    .fadeColor = {0, 0, 0, 255}, // overlay color (alpha overridden per frame)
+    .scale = 1.0f, // sizes as written until rui_set_scale
+    .panelStyleDefault = RUI_PANEL_STYLE_DEFAULT_INIT
+};
+static RUI_THREAD_LOCAL rui_context *rui_ctx = &rui_contextDefault; // context current on this thread
+static RUI_THREAD_LOCAL rui_layout_state *rui_layout = &rui_contextDefault.layout; // layout of the panel being built on this thread
+
+static bool rui_shared_owner(void) { // tweens, budget jobs, change events and undo recording are process-wide: only the default context's own build writes them
+    return rui_layout == &rui_contextDefault.layout; // false in panel jobs and in every other context, whatever thread it is built on
+}
+
+// Skin pool (theme + metrics shared between contexts)
+typedef struct rui_skin { // one resolved theme and its metrics at one scale
+    rui_theme theme; // theme with font defaults applied
+    rui_metrics metrics; // sizes and fonts at scale
+    float scale; // requested scale the metrics were built for
+    unsigned int hash; // theme and scale, compared by cached panels and damage tracking
+    int refs; // contexts pointing here (0 = free slot)
+} rui_skin;
+
+static rui_skin rui_skins[RUI_SKIN_MAX]; // fixed pool of skins
+#ifdef RUI_THREADS
+static pthread_mutex_t rui_skinMutex = PTHREAD_MUTEX_INITIALIZER; // contexts on other threads change themes too
+#endif
+
+// Panel cache state
+typedef struct rui_panel_cache_entry { // texture snapshot of one static panel
+    unsigned int id; // panel identity derived from the title (and its order among same-titled panels)
+    unsigned int contentHash; // caller-provided content hash at capture time
+    unsigned int styleHash; // theme + panel style hash at capture time
+    float alpha; // combined alpha the texture is blitted with (captured at full opacity)
+    Rectangle bounds; // panel rectangle at capture time
+    double contentHeight; // content height recorded while capturing
+    RenderTexture2D target; // texture holding the panel pixels
+    bool valid; // true when the texture can be re-blitted as is
+    unsigned int lastUsed; // frame index of last use (eviction order)
+} rui_panel_cache_entry;
+
+static rui_panel_cache_entry rui_panelCache[RUI_PANEL_CACHE_MAX]; // fixed pool of cached panels
+static unsigned int rui_frameIndex = 0; // frame counter advanced by rui_begin_frame
+
+// Tween pool (structure of arrays, dense in [0, rui_tweenCount))
+static unsigned int rui_tweenId[RUI_TWEEN_MAX]; // key of each slot
+static float rui_tweenValue[RUI_TWEEN_MAX]; // current value
+static float rui_tweenFrom[RUI_TWEEN_MAX]; // value when the tween (re)started
+static float rui_tweenTarget[RUI_TWEEN_MAX]; // value at the end
+static float rui_tweenVelocity[RUI_TWEEN_MAX]; // units per second (springs)
+static float rui_tweenElapsed[RUI_TWEEN_MAX]; // seconds since the start
+static float rui_tweenDuration[RUI_TWEEN_MAX]; // seconds to reach the target
+static float rui_tweenProgress[RUI_TWEEN_MAX]; // elapsed / duration clamped to 0-1
+static unsigned char rui_tweenEase[RUI_TWEEN_MAX]; // rui_ease
+static unsigned int rui_tweenUsed[RUI_TWEEN_MAX]; // rui_frameIndex of the last call naming this tween
+static int rui_tweenCount = 0; // slots in use
+static int rui_tweenMoving = 0; // tweens that have not reached their target
+#define RUI_TWEEN_TABLE (RUI_TWEEN_MAX * 2) // id lookup table, at most half full so probes stay short
+static int rui_tweenTable[RUI_TWEEN_TABLE]; // slot + 1 for each live id (0 = empty), open addressing with linear probing
+static const float rui_easeCurve[RUI_EASE_SPRING + 1][4] = { // each curve as t * (a + t * (b + t * c)) - d * (t >= 0.5) * (1 - 2t)^2, indexed by rui_ease
+    {1.0f, 0.0f, 0.0f, 0.0f}, // linear
+    {0.0f, 1.0f, 0.0f, 0.0f}, // in quad: t^2
+    {2.0f, -1.0f, 0.0f, 0.0f}, // out quad: 1 - (1 - t)^2
+    {0.0f, 2.0f, 0.0f, 1.0f}, // in-out quad: 2t^2, folded into 1 - 2(1 - t)^2 past the middle
+    {3.0f, -3.0f, 1.0f, 0.0f}, // out cubic: 1 - (1 - t)^3
+    {0.0f, 0.0f, 0.0f, 0.0f}, // spring: stepped separately
 };
-static float rui_panelInnerLeft = 0.0f; // cached inner left edge for content placement
-static float rui_panelInnerRight = 0.0f; // cached inner right edge for content placement
-static float rui_panelContentWidth = 0.0f; // target width for auto-layout widgets
-static float rui_scrollOffsetBeforePanel = 0.0f; // backup scroll offset before panel begins
-
-// Fade overlay state
-static bool rui_fadeActive = false; // true while fade animation runs
-static float rui_fadeAlpha = 0.0f; // current overlay alpha 0-255
-static float rui_fadeStartAlpha = 0.0f; // starting alpha for current fade
-static float rui_fadeTargetAlpha = 0.0f; // target alpha to reach at end of fade
-static float rui_fadeDuration = 0.0f; // total animation time in seconds
-static float rui_fadeElapsed = 0.0f; // elapsed time since fade start
-static Color rui_fadeColor = {0, 0, 0, 255}; // overlay color (alpha overridden per frame)
-static rui_text_input *rui_activeTextInput = NULL; // currently focused text input box
-static bool rui_keyboardCaptured = false; // true when UI takes keyboard focus
-static bool rui_themeInitialized = false; // tracks if theme defaults applied
-static float rui_alphaStack[8] = {1.0f}; // alpha stack for nested fades
-static int rui_alphaTop = 0; // alpha stack index
-static float rui_alphaCurrent = 1.0f; // current multiplied alpha
-static bool rui_panelAlphaApplied = false; // true when current panel pushed alpha
+
+// Budget scheduler (dense arrays like the tween pool)
+static unsigned int rui_budgetId[RUI_BUDGET_MAX]; // key of each job
+static rui_budget_fn rui_budgetStep[RUI_BUDGET_MAX]; // slice function
+static void *rui_budgetData[RUI_BUDGET_MAX]; // slice argument
+static int rui_budgetCount = 0; // jobs registered
+static int rui_budgetNext = 0; // round-robin position, so one long job cannot starve the rest
+static int rui_budgetDead = 0; // slots emptied while rui_budget_run steps (NULL step), compacted after it
+static bool rui_budgetRunning = false; // inside rui_budget_run: slots must not move under the loop
+static double rui_budgetSeconds = RUI_FRAME_BUDGET_US * 1e-6; // job time per frame
+static double rui_budgetUsed = 0.0; // time spent at the start of this frame
+
+typedef struct rui_change_event { // newest value of one *_call widget, waiting for its policy
+    void (*onFloat)(float, void *); // exactly one callback is set
+    void (*onBool)(bool, void *);
+    void (*onText)(const char *, void *);
+    void *userData; // with the callback and widget, identifies the slot
+    unsigned int widget; // where the widget sits, so widgets sharing a callback and userData keep separate slots
+    rui_text_input *input; // text widgets: the box whose buffer is reported
+    float number; // slider value
+    bool flag; // toggle value
+    rui_change_mode mode;
+    float seconds; // throttle interval or debounce delay
+    double changedAt; // GetTime() of the newest change
+    double firedAt; // GetTime() of the last callback
+    unsigned int frame; // rui_changeFrame when the widget last ran
+    bool held; // gesture in progress when the widget last ran
+    bool pending; // newest value not delivered yet
+} rui_change_event;
+
+static rui_change_event rui_changes[RUI_CHANGE_MAX]; // widgets with a queued or recent event
+static int rui_changeCount = 0; // entries in rui_changes
+static unsigned int rui_changeFrame = 0; // advanced with the default context's frames
+static rui_change_mode rui_changeDefaultMode = RUI_CHANGE_IMMEDIATE; // policy without rui_change_next
+static float rui_changeDefaultSeconds = 0.0f;
+static rui_change_mode rui_changeNextMode = RUI_CHANGE_IMMEDIATE; // one-shot policy for the next widget
+static float rui_changeNextSeconds = 0.0f;
+static bool rui_changeNextSet = false;
+
+// Draw list state
+static rui_draw_list rui_drawListRecorded = {0}; // last rebuilt frame, replayed between ticks
+static float rui_tickRate = 0.0f; // widget rebuilds per second (0 = every frame)
+static float rui_tickAccumulator = 0.0f; // time since the last scheduled rebuild
+
+// Render-thread handoff state (triple buffer: the game thread writes, the render thread reads, one slot waits in between)
+#define RUI_FRAME_FRESH 4 // flag bit on rui_frameReady: slot holds a frame the reader hasn't taken yet
+static rui_draw_list rui_frameQueue[3]; // three recorded frames rotating between the threads
+static int rui_frameWrite = 0; // slot being recorded (game thread only)
+static int rui_frameReady = 1; // slot last published, plus RUI_FRAME_FRESH (shared, atomic)
+static int rui_frameRead = 2; // slot being submitted (render thread only)
+static bool rui_frameReadValid = false; // reader has taken at least one frame
+
+// Damage tracking state
+typedef struct rui_damage_record { // what a widget looked like when it was drawn
+    Rectangle bounds; // screen area the widget covers
+    unsigned int stateHash; // hash of everything that affects its pixels
+} rui_damage_record;
+
+static bool rui_damageEnabled = false; // tracking is opt-in
+static rui_damage_record rui_damageRecords[2][RUI_DAMAGE_MAX_WIDGETS]; // current/previous frame records
+static int rui_damageRecordCount[2] = {0}; // records written per buffer
+static int rui_damageCurrent = 0; // buffer receiving this frame's records
+static Rectangle rui_damageList[RUI_DAMAGE_MAX_RECTS]; // damaged rectangles for this frame
+static int rui_damageCount = 0; // number of damaged rectangles
+static bool rui_damageFinalized = false; // removed widgets already accounted for
+static float rui_damagePrevFadeAlpha = 0.0f; // fade overlay alpha seen last frame
 
 rui_theme rui_theme_default(void); // forward declare helper for header calc
 
 static float rui_calculate_header_height(bool hasTitle) {
-    const rui_font_style *titleFont = &rui_themeCurrent.titleFont;
-    float padding = 6.0f;
-    float height = hasTitle ? ((float)titleFont->size + padding * 2.0f)
-                            : ((float)rui_panelPadding + padding * 1.5f);
-    if (height < 18.0f) height = 18.0f;
+    const rui_metrics *m = &rui_ctx->skin->metrics;
+    float padding = m->headerPadding;
+    float height = hasTitle ? ((float)m->titleFont.size + padding * 2.0f)
+                            : ((float)rui_layout->panelPadding + padding * 1.5f);
+    if (height < m->minHeaderHeight) height = m->minHeaderHeight;
     return height;
 }
 
@@ -308,371 +1127,2403 @@ static float rui_clamp01(float value) {
     return value;
 }
 
+static bool rui_layout_scrolling(const rui_layout_state *l) { // a panel of this layout has its thumb held or is still gliding
+    if (l->draggingScrollbar || l->scrollVelocity != 0.0f) return true;
+    for (int i = 0; i < RUI_SCROLL_PANELS; ++i) {
+        if (l->scrollPanels[i].used != 0 && (l->scrollPanels[i].dragging || l->scrollPanels[i].velocity != 0.0f)) return true;
+    }
+    return false;
+}
+
 static void rui_push_alpha(float alpha) {
     alpha = rui_clamp01(alpha);
-    float combined = rui_alphaCurrent * alpha;
-    if (rui_alphaTop < (int)(sizeof(rui_alphaStack)/sizeof(rui_alphaStack[0])) - 1) {
-        rui_alphaTop++;
-        rui_alphaStack[rui_alphaTop] = combined;
+    float combined = rui_layout->alphaCurrent * alpha;
+    if (rui_layout->alphaTop < (int)(sizeof(rui_layout->alphaStack)/sizeof(rui_layout->alphaStack[0])) - 1) {
+        rui_layout->alphaTop++;
+        rui_layout->alphaStack[rui_layout->alphaTop] = combined;
     }
-    rui_alphaCurrent = combined;
+    rui_layout->alphaCurrent = combined;
 }
 
 static void rui_pop_alpha(void) {
-    if (rui_alphaTop > 0) {
-        rui_alphaTop--;
-        rui_alphaCurrent = rui_alphaStack[rui_alphaTop];
+    if (rui_layout->alphaTop > 0) {
+        rui_layout->alphaTop--;
+        rui_layout->alphaCurrent = rui_layout->alphaStack[rui_layout->alphaTop];
     } else {
-        rui_alphaCurrent = rui_alphaStack[0];
+        rui_layout->alphaCurrent = rui_layout->alphaStack[0];
     }
 }
 
+static bool rui_note_hover(bool hovered) { // fold a widget's hover state into the frame's hover hash
+    rui_layout->hoverHash = rui_layout->hoverHash * 31u + (hovered ? 2u : 1u);
+    return hovered;
+}
+
 static Color rui_apply_alpha(Color color) {
-    float a = (float)color.a * rui_alphaCurrent;
+    float a = (float)color.a * rui_layout->alphaCurrent;
     if (a < 0.0f) a = 0.0f;
     if (a > 255.0f) a = 255.0f;
     color.a = (unsigned char)a;
     return color;
 }
 
-rui_theme rui_theme_default(void) { // expose default theme values
-    rui_theme theme = RUI_THEME_DEFAULT;
-    Font defaultFont = GetFontDefault();
-    theme.textFont.font = defaultFont;
-    theme.textFont.size = 20;
-    theme.textFont.spacing = 1.0f;
-    theme.titleFont = theme.textFont;
-    theme.titleFont.size = 18;
-    return theme;
+static unsigned int rui_hash_bytes(const void *data, int size, unsigned int seed) { // FNV-1a over raw bytes
+    const unsigned char *bytes = (const unsigned char *)data;
+    unsigned int hash = seed ? seed : 2166136261u; // zero seed starts from the FNV offset basis
+    for (int i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
-static void rui_apply_font_defaults(rui_font_style *style, const rui_font_style *fallback) {
-    if (style->font.texture.id == 0) {
-        style->font = fallback ? fallback->font : GetFontDefault();
-    }
-    if (style->size <= 0) {
-        style->size = fallback ? fallback->size : 20;
-    }
-    if (style->spacing == 0.0f) {
-        style->spacing = fallback ? fallback->spacing : 1.0f;
+unsigned int rui_hash_string(const char *text, unsigned int seed) { // FNV-1a over a null-terminated string
+    unsigned int hash = seed ? seed : 2166136261u;
+    if (!text) return hash;
+    while (*text) {
+        hash ^= (unsigned char)*text++;
+        hash *= 16777619u;
     }
+    return hash;
 }
 
-void rui_theme_set(const rui_theme *theme) { // replace current theme
-    if (!theme) return;
-    rui_themeCurrent = *theme;
-
-    rui_apply_font_defaults(&rui_themeCurrent.textFont, NULL);
-    rui_apply_font_defaults(&rui_themeCurrent.titleFont, &rui_themeCurrent.textFont);
+static unsigned int rui_hash_int(int value, unsigned int seed) { // fold one integer into a hash
+    return rui_hash_bytes(&value, (int)sizeof(value), seed);
+}
 
-    rui_panelStyleDefault = rui_themeCurrent.panel;
-    rui_themeInitialized = true;
+static unsigned int rui_hash_float(float value, unsigned int seed) { // fold one float into a hash
+    return rui_hash_bytes(&value, (int)sizeof(value), seed);
 }
 
-const rui_theme *rui_theme_get(void) { // access current theme pointer
-    return &rui_themeCurrent;
+static unsigned int rui_hash_font(const rui_font_style *fs, unsigned int seed) { // hash the parts of a font style that affect pixels
+    seed = rui_hash_bytes(&fs->font.texture.id, (int)sizeof(fs->font.texture.id), seed);
+    seed = rui_hash_bytes(&fs->size, (int)sizeof(fs->size), seed);
+    return rui_hash_bytes(&fs->spacing, (int)sizeof(fs->spacing), seed);
 }
 
-void rui_theme_reset(void) { // restore default theme
-    rui_theme theme = rui_theme_default();
-    rui_theme_set(&theme);
-    rui_alphaStack[0] = 1.0f;
-    rui_alphaTop = 0;
-    rui_alphaCurrent = 1.0f;
+static unsigned int rui_hash_theme(const rui_theme *theme) { // colour blocks are padding-free, fonts are hashed field by field
+    unsigned int hash = rui_hash_bytes(&theme->panel, (int)sizeof(theme->panel), 0);
+    hash = rui_hash_bytes(&theme->button, (int)sizeof(theme->button), hash);
+    hash = rui_hash_bytes(&theme->slider, (int)sizeof(theme->slider), hash);
+    hash = rui_hash_bytes(&theme->toggle, (int)sizeof(theme->toggle), hash);
+    hash = rui_hash_bytes(&theme->textInput, (int)sizeof(theme->textInput), hash);
+    hash = rui_hash_font(&theme->textFont, hash);
+    return rui_hash_font(&theme->titleFont, hash);
 }
 
-void rui_set_default_panel_style(rui_panel_style style) { // override default panel style independent of theme
-    rui_panelStyleDefault = style;
+static void rui_damage_add(Rectangle area) { // merge a changed region into the damage list
+    if (area.width <= 0.0f || area.height <= 0.0f) return;
+    area.x -= 2.0f; // outlines and glyph overhang can spill slightly past widget bounds
+    area.y -= 2.0f;
+    area.width += 4.0f;
+    area.height += 4.0f;
+
+    int best = -1;
+    float bestGrowth = 0.0f;
+    for (int i = 0; i < rui_damageCount; ++i) {
+        Rectangle d = rui_damageList[i];
+        float left = fminf(d.x, area.x), top = fminf(d.y, area.y);
+        float right = fmaxf(d.x + d.width, area.x + area.width), bottom = fmaxf(d.y + d.height, area.y + area.height);
+        Rectangle merged = { left, top, right - left, bottom - top };
+        if (CheckCollisionRecs(d, area)) { // overlapping regions always merge
+            rui_damageList[i] = merged;
+            return;
+        }
+        float growth = merged.width * merged.height - d.width * d.height;
+        if (best < 0 || growth < bestGrowth) {
+            best = i;
+            bestGrowth = growth;
+        }
+    }
+
+    if (rui_damageCount < RUI_DAMAGE_MAX_RECTS) {
+        rui_damageList[rui_damageCount++] = area;
+    } else { // list full: grow the rectangle that expands the least
+        Rectangle d = rui_damageList[best];
+        float left = fminf(d.x, area.x), top = fminf(d.y, area.y);
+        float right = fmaxf(d.x + d.width, area.x + area.width), bottom = fmaxf(d.y + d.height, area.y + area.height);
+        rui_damageList[best] = (Rectangle){ left, top, right - left, bottom - top };
+    }
 }
 
-rui_panel_style rui_get_default_panel_style(void) { // read current default panel style
-    return rui_panelStyleDefault;
+static void rui_damage_track(Rectangle bounds, unsigned int stateHash) { // record a drawn widget and damage it if it changed
+    if (!rui_damageEnabled || rui_layout->panelCacheEntry) return; // cached panels are tracked as one unit
+    if (rui_layout != &rui_contextDefault.layout) return; // panel jobs are tracked as one unit when merged; other contexts not at all
+    stateHash = rui_hash_bytes(&rui_layout->alphaCurrent, (int)sizeof(rui_layout->alphaCurrent), stateHash ^ rui_ctx->skin->hash);
+
+    int slot = rui_damageRecordCount[rui_damageCurrent];
+    if (slot >= RUI_DAMAGE_MAX_WIDGETS) { // beyond the table: assume changed
+        rui_damage_add(bounds);
+        return;
+    }
+    rui_damageRecordCount[rui_damageCurrent] = slot + 1;
+    rui_damage_record *record = &rui_damageRecords[rui_damageCurrent][slot];
+    record->bounds = bounds;
+    record->stateHash = stateHash;
+
+    int previous = 1 - rui_damageCurrent;
+    if (slot >= rui_damageRecordCount[previous]) { // new widget this frame
+        rui_damage_add(bounds);
+        return;
+    }
+    const rui_damage_record *old = &rui_damageRecords[previous][slot];
+    if (old->stateHash != stateHash ||
+        old->bounds.x != bounds.x || old->bounds.y != bounds.y ||
+        old->bounds.width != bounds.width || old->bounds.height != bounds.height) {
+        rui_damage_add(old->bounds); // uncover where it was
+        rui_damage_add(bounds); // and paint where it is
+    }
 }
 
-void rui_begin_frame(void) { // grab per-frame input state
-    if (!rui_themeInitialized) {
-        rui_theme_reset();
+static void rui_damage_begin_frame(bool rebuild) { // swap record buffers and account for the fade overlay
+    rui_damageCount = 0;
+    if (rebuild) {
+        rui_damageCurrent = 1 - rui_damageCurrent;
+        rui_damageRecordCount[rui_damageCurrent] = 0;
+        rui_damageFinalized = false;
+    } else { // replayed frame: records stay as rebuilt, only patches can damage
+        rui_damageFinalized = true;
+    }
+    if (rui_ctx->fadeAlpha != rui_damagePrevFadeAlpha) { // overlay covers the whole render surface
+        rui_damage_add((Rectangle){ 0.0f, 0.0f, (float)GetRenderWidth(), (float)GetRenderHeight() });
     }
+    rui_damagePrevFadeAlpha = rui_ctx->fadeAlpha;
+}
 
-    rui_mouse = GetMousePosition(); // cache mouse coordinates
-    rui_mousePressed = IsMouseButtonPressed(MOUSE_LEFT_BUTTON); // see if left button pressed
+static void rui_damage_finalize(void) { // widgets drawn last frame but not this one leave holes
+    if (rui_damageFinalized) return;
+    int previous = 1 - rui_damageCurrent;
+    for (int i = rui_damageRecordCount[rui_damageCurrent]; i < rui_damageRecordCount[previous]; ++i) {
+        rui_damage_add(rui_damageRecords[previous][i].bounds);
+    }
+    rui_damageFinalized = true;
+}
 
-    if (rui_fadeActive) { // advance fade animation when active
-        rui_fadeElapsed += GetFrameTime(); // accrue frame delta time
-        if (rui_fadeDuration <= 0.0f) { // handle zero duration edge case
-            rui_fadeAlpha = rui_fadeTargetAlpha; // jump straight to target alpha
-            rui_fadeActive = false; // stop animation immediately
-        } else {
-            float t = rui_fadeElapsed / rui_fadeDuration; // normalize elapsed time
-            if (t >= 1.0f) { // clamp when animation completes
-                t = 1.0f;
-                rui_fadeActive = false; // mark animation done
-            }
-            rui_fadeAlpha = rui_fadeStartAlpha + (rui_fadeTargetAlpha - rui_fadeStartAlpha) * t; // interpolate alpha
-        }
+void rui_damage_enable(bool enabled) { // start/stop change tracking
+    if (enabled && !rui_damageEnabled) { // first tracked frame damages everything it draws
+        rui_damageRecordCount[0] = 0;
+        rui_damageRecordCount[1] = 0;
+        rui_damageCount = 0;
     }
+    rui_damageEnabled = enabled;
 }
 
-// --- Basic Widgets ---
+Rectangle rui_damage_rect(void) { // union of all damaged rectangles
+    rui_damage_finalize();
+    if (rui_damageCount == 0) return (Rectangle){ 0 };
+    float left = rui_damageList[0].x, top = rui_damageList[0].y;
+    float right = left + rui_damageList[0].width, bottom = top + rui_damageList[0].height;
+    for (int i = 1; i < rui_damageCount; ++i) {
+        left = fminf(left, rui_damageList[i].x);
+        top = fminf(top, rui_damageList[i].y);
+        right = fmaxf(right, rui_damageList[i].x + rui_damageList[i].width);
+        bottom = fmaxf(bottom, rui_damageList[i].y + rui_damageList[i].height);
+    }
+    return (Rectangle){ left, top, right - left, bottom - top };
+}
 
-void rui_label(const char *text, Vector2 pos) { // draw plain text label with default color
-    rui_label_color(text, pos, rui_themeCurrent.panel.labelColor); // delegate to colored label helper with theme tone
+int rui_damage_rects(Rectangle *out, int maxCount) { // copy damaged rectangles for scissored redraws
+    rui_damage_finalize();
+    int count = rui_damageCount < maxCount ? rui_damageCount : maxCount;
+    for (int i = 0; i < count; ++i) out[i] = rui_damageList[i];
+    return count;
 }
 
-void rui_label_color(const char *text, Vector2 pos, Color color) { // draw text label with supplied color
-    const rui_font_style *fs = &rui_themeCurrent.textFont;
-    DrawTextEx(fs->font, text, (Vector2){ pos.x, pos.y }, (float)fs->size, fs->spacing, rui_apply_alpha(color)); // render text with themed font
+// --- Memory ---
+static rui_allocator rui_allocatorCurrent = {0}; // runtime hooks, zero = RUI_REALLOC/RUI_FREE
+static bool rui_allocStrict = false; // refuse heap allocations
+static int rui_allocFrameCount = 0; // allocations this frame (atomic: jobs allocate on workers)
+static int rui_allocFrameBytes = 0; // bytes this frame (atomic)
+static int rui_allocLastCount = 0; // previous frame's allocations
+static int rui_allocLastBytes = 0; // previous frame's bytes
+static int rui_allocTotalCount = 0; // allocations since startup (atomic)
+static int rui_allocRefused = 0; // refused in strict mode (atomic)
+
+static unsigned char *rui_arena = NULL; // frame arena block
+static int rui_arenaCapacity = 0; // arena bytes
+static int rui_arenaUsed = 0; // bytes handed out this frame, including spills (atomic bump pointer)
+static int rui_arenaPeak = 0; // largest rui_arenaUsed seen at a reset
+static void *rui_arenaOverflow[RUI_FRAME_ARENA_OVERFLOW]; // heap blocks used once the arena ran out
+static int rui_arenaOverflowCount = 0; // slots claimed in rui_arenaOverflow (atomic)
+
+static void *rui_realloc(void *ptr, size_t size) { // single entry point for rui heap growth
+    if (rui_allocStrict) {
+        RUI_ATOMIC_ADD(&rui_allocRefused, 1);
+        return NULL; // callers already treat NULL as "keep the old buffer"
+    }
+    RUI_ATOMIC_ADD(&rui_allocFrameCount, 1);
+    RUI_ATOMIC_ADD(&rui_allocFrameBytes, (int)size);
+    RUI_ATOMIC_ADD(&rui_allocTotalCount, 1);
+    if (rui_allocatorCurrent.reallocate) return rui_allocatorCurrent.reallocate(ptr, size, rui_allocatorCurrent.userData);
+    return RUI_REALLOC(ptr, size);
 }
 
-bool rui_button(const char *text, Rectangle bounds) { // draw interactive button
-    const rui_button_style *bs = &rui_themeCurrent.button; // fetch theme colours
-    bool hovered = CheckCollisionPointRec(rui_mouse, bounds); // check if mouse over button
-    bool pressed = hovered && rui_mousePressed; // register press only when hovered
+static void rui_free(void *ptr) {
+    if (!ptr) return;
+    if (rui_allocatorCurrent.release) rui_allocatorCurrent.release(ptr, rui_allocatorCurrent.userData);
+    else RUI_FREE(ptr);
+}
 
-    Color bg = hovered ? bs->hover : bs->normal; // choose hover background color
-    if (pressed) bg = bs->pressed; // darken when actively pressed
+void rui_set_allocator(const rui_allocator *allocator) { // memory from the old allocator must already be released
+    rui_allocatorCurrent = allocator ? *allocator : (rui_allocator){0};
+}
 
-    DrawRectangleRec(bounds, rui_apply_alpha(bg)); // fill button background
-    DrawRectangleLinesEx(bounds, 2, rui_apply_alpha(bs->border)); // outline button for contrast
+rui_alloc_stats rui_get_alloc_stats(void) {
+    rui_alloc_stats stats;
+    stats.frameAllocations = RUI_ATOMIC_LOAD(&rui_allocFrameCount);
+    stats.frameBytes = RUI_ATOMIC_LOAD(&rui_allocFrameBytes);
+    stats.lastFrameAllocations = rui_allocLastCount;
+    stats.lastFrameBytes = rui_allocLastBytes;
+    stats.totalAllocations = RUI_ATOMIC_LOAD(&rui_allocTotalCount);
+    stats.refusedAllocations = RUI_ATOMIC_LOAD(&rui_allocRefused);
+    stats.arenaUsed = RUI_ATOMIC_LOAD(&rui_arenaUsed);
+    stats.arenaCapacity = rui_arenaCapacity;
+    stats.arenaPeak = rui_arenaPeak;
+    return stats;
+}
 
-    const rui_font_style *fs = &rui_themeCurrent.textFont;
-    Vector2 textSize = MeasureTextEx(fs->font, text, (float)fs->size, fs->spacing);
-    float textX = bounds.x + (bounds.width - textSize.x) * 0.5f;
-    float textY = bounds.y + (bounds.height - textSize.y) * 0.5f;
-    DrawTextEx(fs->font, text, (Vector2){ textX, textY }, (float)fs->size, fs->spacing, rui_apply_alpha(bs->text)); // draw button label
+void rui_set_alloc_strict(bool strict) { // enable after warm-up frames have sized every buffer
+    rui_allocStrict = strict;
+}
 
-    return pressed; // return true when clicked
+void *rui_frame_alloc(int size) { // lock-free bump allocation, safe from panel jobs
+    if (size <= 0) return NULL;
+    size = (size + 15) & ~15;
+    int end = RUI_ATOMIC_ADD(&rui_arenaUsed, size);
+    if (end <= rui_arenaCapacity) return rui_arena + (end - size);
+    int slot = RUI_ATOMIC_ADD(&rui_arenaOverflowCount, 1) - 1; // arena full: spill to the heap until the next reset grows it
+    if (slot >= RUI_FRAME_ARENA_OVERFLOW) return NULL;
+    void *block = rui_realloc(NULL, (size_t)size);
+    rui_arenaOverflow[slot] = block;
+    return block;
 }
 
-bool rui_button_call(const char *text, Rectangle bounds, void (*callback)(void *), void *userData) { // draw button and fire callback
-    bool pressed = rui_button(text, bounds); // reuse core button drawing logic
-    if (pressed && callback) { // invoke user callback only when pressed and provided
-        callback(userData); // call user-supplied function with context pointer
+static void rui_frame_arena_reset(void) { // frame start, no other thread may be allocating
+    int overflowCount = rui_arenaOverflowCount < RUI_FRAME_ARENA_OVERFLOW ? rui_arenaOverflowCount : RUI_FRAME_ARENA_OVERFLOW;
+    for (int i = 0; i < overflowCount; ++i) rui_free(rui_arenaOverflow[i]);
+    rui_arenaOverflowCount = 0;
+    if (rui_arenaUsed > rui_arenaPeak) rui_arenaPeak = rui_arenaUsed;
+    int needed = rui_arenaPeak > RUI_FRAME_ARENA_SIZE ? rui_arenaPeak : RUI_FRAME_ARENA_SIZE;
+    if (rui_arenaUsed > 0 && needed > rui_arenaCapacity) { // grow once so the next frames don't spill
+        void *grown = rui_realloc(NULL, (size_t)needed);
+        if (grown) {
+            rui_free(rui_arena);
+            rui_arena = (unsigned char *)grown;
+            rui_arenaCapacity = needed;
+        }
     }
-    return pressed; // propagate pressed state to caller
+    rui_arenaUsed = 0;
 }
 
-static bool rui_draw_close_button(Rectangle bounds, const char *label, Color borderColor) { // render close button in panel chrome
-    bool hovered = CheckCollisionPointRec(rui_mouse, bounds); // hover detection
-    bool pressed = hovered && rui_mousePressed; // click detection
+void rui_frame_arena_free(void) {
+    rui_frame_arena_reset(); // frees spilled blocks
+    rui_free(rui_arena);
+    rui_arena = NULL;
+    rui_arenaCapacity = 0;
+}
 
-    Color base = hovered ? (Color){210, 80, 80, 255} : (Color){190, 60, 60, 255}; // background tint
-    if (pressed) base = (Color){150, 40, 40, 255}; // darker when pressed
+static void rui_alloc_begin_frame(void) { // roll the per-frame counters and recycle the arena
+    rui_frame_arena_reset();
+    rui_allocLastCount = RUI_ATOMIC_EXCHANGE(&rui_allocFrameCount, 0);
+    rui_allocLastBytes = RUI_ATOMIC_EXCHANGE(&rui_allocFrameBytes, 0);
+}
 
-    DrawRectangleRec(bounds, rui_apply_alpha(base)); // fill button
-    DrawRectangleLinesEx(bounds, 2, rui_apply_alpha(borderColor)); // outline to match panel
+// --- Tweens ---
+static int rui_tween_home(unsigned int id) { // preferred table index (Fibonacci hashing spreads sequential ids)
+    return (int)((id * 2654435761u) % (unsigned int)RUI_TWEEN_TABLE);
+}
 
-    const char *text = label ? label : "X"; // default label
-    const rui_font_style *tf = &rui_themeCurrent.titleFont;
-    float baseSize = (float)tf->size;
-    if (baseSize <= 0.0f) baseSize = 18.0f;
-    float drawSize = baseSize;
-    if (drawSize > bounds.height - 4.0f) drawSize = bounds.height - 4.0f; // fit inside button
-    if (drawSize < 8.0f) drawSize = 8.0f;
-    float spacing = tf->spacing;
-    if (baseSize != drawSize) {
-        float scale = drawSize / baseSize;
-        spacing *= scale;
-    }
-    Vector2 textSize = MeasureTextEx(tf->font, text, drawSize, spacing);
-    Vector2 textPos = {
-        bounds.x + (bounds.width - textSize.x) * 0.5f,
-        bounds.y + (bounds.height - textSize.y) * 0.5f
-    };
-    DrawTextEx(tf->font, text, textPos, drawSize, spacing, rui_apply_alpha(WHITE)); // draw label centered
+static int rui_tween_probe(unsigned int id) { // table index holding id, or the empty index where it belongs
+    int h = rui_tween_home(id);
+    while (rui_tweenTable[h] != 0 && rui_tweenId[rui_tweenTable[h] - 1] != id) h = (h + 1) % RUI_TWEEN_TABLE;
+    return h;
+}
 
-    return pressed; // signal click
+static int rui_tween_find(unsigned int id) { // O(1) per call, so N animated widgets cost O(N) per frame
+    return rui_tweenTable[rui_tween_probe(id)] - 1;
 }
 
-float rui_slider(Rectangle bounds, float value, float minValue, float maxValue) { // draw horizontal slider and return new value
-    if (maxValue < minValue) { // guard against inverted range
-        float tmp = minValue;
-        minValue = maxValue;
-        maxValue = tmp;
+static void rui_tween_unlink(unsigned int id) { // empty id's table entry, shifting later probes back so no tombstones are needed
+    int hole = rui_tween_probe(id);
+    rui_tweenTable[hole] = 0;
+    for (int j = (hole + 1) % RUI_TWEEN_TABLE; rui_tweenTable[j] != 0; j = (j + 1) % RUI_TWEEN_TABLE) {
+        int home = rui_tween_home(rui_tweenId[rui_tweenTable[j] - 1]);
+        if ((hole - home + RUI_TWEEN_TABLE) % RUI_TWEEN_TABLE < (j - home + RUI_TWEEN_TABLE) % RUI_TWEEN_TABLE) { // hole lies on j's probe path
+            rui_tweenTable[hole] = rui_tweenTable[j];
+            rui_tweenTable[j] = 0;
+            hole = j;
+        }
     }
+}
 
-    if ( bounds.width < 12.0f ) bounds.width = 12.0f; // ensure room for knob
-    float trackHeight = 6.0f; // thickness of slider track
-    float trackY = bounds.y + (bounds.height - trackHeight) * 0.5f; // center track vertically
-    Rectangle track = { bounds.x, trackY, bounds.width, trackHeight }; // track rectangle
-    DrawRectangleRec(track, rui_apply_alpha(rui_themeCurrent.slider.track)); // draw track background
+static int rui_tween_slot(unsigned int id, float initial) { // find or create; -1 when the pool is full
+    int h = rui_tween_probe(id);
+    int slot = rui_tweenTable[h] - 1;
+    if (slot >= 0 || rui_tweenCount >= RUI_TWEEN_MAX) return slot;
+    slot = rui_tweenCount++;
+    rui_tweenTable[h] = slot + 1;
+    rui_tweenId[slot] = id;
+    rui_tweenValue[slot] = initial;
+    rui_tweenFrom[slot] = initial;
+    rui_tweenTarget[slot] = initial;
+    rui_tweenVelocity[slot] = 0.0f;
+    rui_tweenElapsed[slot] = 0.0f;
+    rui_tweenDuration[slot] = 0.0f;
+    rui_tweenProgress[slot] = 1.0f;
+    rui_tweenEase[slot] = RUI_EASE_LINEAR;
+    return slot;
+}
 
-    float knobWidth = 12.0f; // knob width
-    float travel = bounds.width - knobWidth; // horizontal travel distance for knob
-    float clampedValue = Clamp(value, minValue, maxValue); // ensure value within range
-    float t = (maxValue - minValue) > 0 ? (clampedValue - minValue) / (maxValue - minValue) : 0.0f; // normalize value 0-1
-    float knobX = bounds.x + t * travel; // compute knob position
-    Rectangle knob = { knobX, bounds.y + (bounds.height - knobWidth) * 0.5f, knobWidth, knobWidth }; // knob bounds
+static void rui_tween_remove_slot(int slot) { // swap the last slot in to keep the arrays dense
+    rui_tween_unlink(rui_tweenId[slot]);
+    int last = --rui_tweenCount;
+    if (slot != last) rui_tweenTable[rui_tween_probe(rui_tweenId[last])] = slot + 1; // the moved id now lives in slot
+    rui_tweenId[slot] = rui_tweenId[last];
+    rui_tweenValue[slot] = rui_tweenValue[last];
+    rui_tweenFrom[slot] = rui_tweenFrom[last];
+    rui_tweenTarget[slot] = rui_tweenTarget[last];
+    rui_tweenVelocity[slot] = rui_tweenVelocity[last];
+    rui_tweenElapsed[slot] = rui_tweenElapsed[last];
+    rui_tweenDuration[slot] = rui_tweenDuration[last];
+    rui_tweenProgress[slot] = rui_tweenProgress[last];
+    rui_tweenEase[slot] = rui_tweenEase[last];
+    rui_tweenUsed[slot] = rui_tweenUsed[last];
+}
 
-    bool hovered = CheckCollisionPointRec(rui_mouse, knob) || CheckCollisionPointRec(rui_mouse, track); // hover on knob or track
-    static bool dragging = false; // track global dragging state (single slider usage per frame)
-    static Rectangle activeSlider = {0}; // remember which slider is active
+static void rui_tween_begin(int slot, float from, float to, float duration, rui_ease ease) {
+    rui_tweenFrom[slot] = from;
+    rui_tweenValue[slot] = from;
+    rui_tweenTarget[slot] = to;
+    rui_tweenElapsed[slot] = 0.0f;
+    rui_tweenDuration[slot] = duration > 0.0f ? duration : 0.0f;
+    rui_tweenProgress[slot] = duration > 0.0f && from != to ? 0.0f : 1.0f;
+    rui_tweenEase[slot] = (unsigned char)(ease >= RUI_EASE_LINEAR && ease <= RUI_EASE_SPRING ? ease : RUI_EASE_LINEAR); // indexes rui_easeCurve
+    if (ease != RUI_EASE_SPRING) rui_tweenVelocity[slot] = 0.0f;
+    if (rui_tweenProgress[slot] >= 1.0f) rui_tweenValue[slot] = to;
+    else rui_tweenMoving++; // counted until the next update recounts
+}
 
-    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
-        if (!dragging && hovered) { // start drag when first clicking on slider
-            dragging = true;
-            activeSlider = bounds;
-        }
-    } else {
-        dragging = false; // release drag when button up
+static void rui_tweens_update(float dt) { // one pass over the pool per frame
+    int count = rui_tweenCount;
+    for (int i = 0; i < count; ++i) { // timing: plain float arrays and selects (fminf's NaN rules would block vectorizing)
+        float elapsed = rui_tweenElapsed[i] + dt;
+        float duration = rui_tweenDuration[i] > 0.0f ? rui_tweenDuration[i] : 1e-6f;
+        float progress = elapsed / duration;
+        rui_tweenElapsed[i] = elapsed;
+        rui_tweenProgress[i] = progress < 1.0f ? progress : 1.0f;
     }
 
-    if (dragging && activeSlider.x == bounds.x && activeSlider.y == bounds.y && activeSlider.width == bounds.width) {
-        float mouseT = (rui_mouse.x - bounds.x - knobWidth * 0.5f) / travel; // compute based on mouse x
-        if (travel <= 0) mouseT = 0;
-        if (mouseT < 0) mouseT = 0;
-        if (mouseT > 1) mouseT = 1;
-        clampedValue = minValue + mouseT * (maxValue - minValue); // update value based on mouse position
-        t = mouseT; // update normalized value for knob drawing
-        knob.x = bounds.x + t * travel; // update knob position
+    int moving = 0, springs = 0;
+    for (int i = 0; i < count; ++i) { // curves: one polynomial per ease from rui_easeCurve, so every tween runs the same arithmetic
+        float t = rui_tweenProgress[i];
+        int ease = rui_tweenEase[i];
+        float w = 1.0f - 2.0f * t;
+        float e = t * (rui_easeCurve[ease][0] + t * (rui_easeCurve[ease][1] + t * rui_easeCurve[ease][2]))
+                - rui_easeCurve[ease][3] * (float)isgreaterequal(t, 0.5f) * w * w; // isgreaterequal is a quiet compare, so strict float rules need no branch for it
+        float spring = (float)(ease == RUI_EASE_SPRING);
+        float eased = rui_tweenFrom[i] + (rui_tweenTarget[i] - rui_tweenFrom[i]) * e;
+        rui_tweenValue[i] = spring * rui_tweenValue[i] + (1.0f - spring) * eased; // springs keep their value and are stepped below
+        moving += (ease != RUI_EASE_SPRING) & isless(t, 1.0f);
+        springs += ease == RUI_EASE_SPRING;
     }
+    for (int i = 0; springs > 0 && i < count; ++i) { // springs: exact critically damped step, stable for any dt (skipped when there are none)
+        if (rui_tweenEase[i] != RUI_EASE_SPRING) continue;
+        float from = rui_tweenFrom[i], to = rui_tweenTarget[i];
+        float omega = 10.0f / (rui_tweenDuration[i] > 0.0f ? rui_tweenDuration[i] : 1e-6f);
+        float y = rui_tweenValue[i] - to, v = rui_tweenVelocity[i];
+        float decay = expf(-omega * dt);
+        float k = (v + omega * y) * dt;
+        float x = to + (y + k) * decay;
+        v = (v - omega * k) * decay;
+        float range = fmaxf(1.0f, fabsf(to - from));
+        bool settled = fabsf(to - x) < 1e-3f * range && fabsf(v) < 1e-2f * range;
+        rui_tweenVelocity[i] = settled ? 0.0f : v;
+        rui_tweenValue[i] = settled ? to : x;
+        rui_tweenProgress[i] = settled ? 1.0f : fminf(rui_tweenProgress[i], 0.999f); // springs finish when settled, not on time
+        moving += settled ? 0 : 1;
+    }
+    rui_tweenMoving = moving;
 
-    Color knobColor = dragging ? rui_themeCurrent.slider.knobDrag
-                      : (hovered ? rui_themeCurrent.slider.knobHover : rui_themeCurrent.slider.knob); // knob tint
-    DrawRectangleRec(knob, rui_apply_alpha(knobColor)); // draw knob
-    DrawRectangleLinesEx(knob, 2, rui_apply_alpha(rui_themeCurrent.button.border)); // outline knob using button border colour
+    for (int i = rui_tweenCount - 1; i >= 0; --i) { // forget finished tweens nobody asked about lately
+        if (rui_tweenProgress[i] >= 1.0f && rui_frameIndex - rui_tweenUsed[i] > (unsigned int)RUI_TWEEN_EXPIRE_FRAMES) rui_tween_remove_slot(i);
+    }
+}
 
-    return clampedValue; // return potentially updated value
+float rui_tween(unsigned int id, float target, float duration, rui_ease ease) { // retargets smoothly from wherever the value is now
+    if (!rui_shared_owner()) return target; // other contexts and panel jobs do not animate
+    int slot = rui_tween_slot(id, target);
+    if (slot < 0) return target;
+    rui_tweenUsed[slot] = rui_frameIndex;
+    if (rui_tweenTarget[slot] != target) rui_tween_begin(slot, rui_tweenValue[slot], target, duration, ease);
+    return rui_tweenValue[slot];
 }
 
-bool rui_toggle(Rectangle bounds, bool value, const char *label) { // draw checkbox and label
-    float boxSize = bounds.height; // square checkbox fitting height
-    if (boxSize > bounds.width) boxSize = bounds.width; // ensure fits inside bounds
-    Rectangle box = { bounds.x, bounds.y, boxSize, boxSize }; // checkbox rectangle
-    Rectangle textBounds = { bounds.x + boxSize + 8.0f, bounds.y, bounds.width - boxSize - 8.0f, bounds.height }; // text area
+float rui_tween_start(unsigned int id, float from, float to, float duration, rui_ease ease) {
+    if (!rui_shared_owner()) return to;
+    int slot = rui_tween_slot(id, from);
+    if (slot < 0) return to;
+    rui_tweenUsed[slot] = rui_frameIndex;
+    rui_tweenVelocity[slot] = 0.0f;
+    rui_tween_begin(slot, from, to, duration, ease);
+    return rui_tweenValue[slot];
+}
 
-    bool hovered = CheckCollisionPointRec(rui_mouse, bounds); // hover when cursor over total bounds
-    bool toggled = hovered && rui_mousePressed; // flip state only on press while hovered
-    if (toggled) value = !value; // toggle value on click
+void rui_tween_set(unsigned int id, float value) {
+    if (!rui_shared_owner()) return;
+    int slot = rui_tween_slot(id, value);
+    if (slot < 0) return;
+    rui_tweenUsed[slot] = rui_frameIndex;
+    rui_tweenVelocity[slot] = 0.0f;
+    rui_tween_begin(slot, value, value, 0.0f, RUI_EASE_LINEAR);
+}
 
-    Color border = hovered ? rui_themeCurrent.toggle.borderHover : rui_themeCurrent.toggle.border; // border tint when hovered
-    DrawRectangleLinesEx(box, 2, rui_apply_alpha(border)); // outline checkbox
-    Color fillColor = value ? rui_themeCurrent.toggle.fillActive : rui_themeCurrent.toggle.fill; // fill based on state
-    DrawRectangleRec((Rectangle){ box.x + 3, box.y + 3, box.width - 6, box.height - 6 }, rui_apply_alpha(fillColor));
+float rui_tween_value(unsigned int id, float fallback) { // panel jobs of the default context may read: the pool only changes between job runs
+    if (rui_ctx != &rui_contextDefault) return fallback;
+    int slot = rui_tween_find(id);
+    if (slot < 0) return fallback;
+    if (rui_shared_owner()) rui_tweenUsed[slot] = rui_frameIndex;
+    return rui_tweenValue[slot];
+}
 
-    if (label) { // draw optional label text
-        const rui_font_style *fs = &rui_themeCurrent.textFont;
-        Vector2 textSize = MeasureTextEx(fs->font, label, (float)fs->size, fs->spacing);
-        Vector2 pos = {
-            textBounds.x,
-            bounds.y + (bounds.height - textSize.y) * 0.5f
-        };
-        DrawTextEx(fs->font, label, pos, (float)fs->size, fs->spacing, rui_apply_alpha(rui_themeCurrent.toggle.label));
-    }
+bool rui_tween_active(unsigned int id) {
+    if (rui_ctx != &rui_contextDefault) return false;
+    int slot = rui_tween_find(id);
+    return slot >= 0 && rui_tweenProgress[slot] < 1.0f;
+}
 
-    return value; // return possibly toggled value
+bool rui_tweens_active(void) {
+    return rui_ctx == &rui_contextDefault && rui_tweenMoving > 0;
 }
 
-float rui_slider_call(Rectangle bounds, float value, float minValue, float maxValue, void (*callback)(float, void *), void *userData) { // slider with callback
-    float newValue = rui_slider(bounds, value, minValue, maxValue); // draw slider and get new value
-    if (callback && newValue != value) { // invoke callback when value changes
-        callback(newValue, userData); // pass updated value and user context
+void rui_tween_remove(unsigned int id) {
+    if (!rui_shared_owner()) return;
+    int slot = rui_tween_find(id);
+    if (slot >= 0) rui_tween_remove_slot(slot);
+}
+
+// --- Budget Scheduler ---
+static int rui_budget_find(unsigned int id) {
+    for (int i = 0; i < rui_budgetCount; ++i) {
+        if (rui_budgetId[i] == id && rui_budgetStep[i]) return i;
     }
-    return newValue; // return current slider value
+    return -1;
 }
 
-bool rui_toggle_call(Rectangle bounds, bool value, const char *label, void (*callback)(bool, void *), void *userData) { // toggle with callback
-    bool newValue = rui_toggle(bounds, value, label); // draw toggle and get new state
-    if (callback && newValue != value) { // invoke callback on state change
-        callback(newValue, userData); // pass new state to user handler
+static void rui_budget_remove_slot(int slot) { // swap the last job in to keep the arrays dense
+    if (rui_budgetRunning) { // a step finished or cancelled a job: only mark it, the loop holds indices
+        rui_budgetStep[slot] = NULL;
+        rui_budgetData[slot] = NULL;
+        rui_budgetDead++;
+        return;
     }
-    return newValue; // return current toggle state
+    int last = --rui_budgetCount;
+    rui_budgetId[slot] = rui_budgetId[last];
+    rui_budgetStep[slot] = rui_budgetStep[last];
+    rui_budgetData[slot] = rui_budgetData[last];
 }
 
-rui_text_input rui_text_input_init(char *buffer, int capacity) { // convenience initializer for text input state
-    rui_text_input input = {0}; // zero initialize struct
-    input.buffer = buffer; // assign caller buffer
-    input.capacity = capacity; // set capacity
-    if (buffer && capacity > 0) { // ensure buffer valid
-        input.length = (int)TextLength(buffer); // pre-populate length from existing text
-        if (input.length >= capacity) { // clamp length to capacity - 1
-            input.length = capacity - 1;
-            buffer[input.length] = '\0';
+static void rui_budget_run(void) { // step jobs round-robin until the frame's slice is spent
+    rui_budgetUsed = 0.0;
+    if (rui_budgetCount == 0) return;
+    double start = GetTime();
+    double now = start;
+    rui_budgetRunning = true; // steps may submit (appends) or cancel (marks) jobs
+    do {
+        if (rui_budgetNext >= rui_budgetCount) rui_budgetNext = 0;
+        int slot = rui_budgetNext++;
+        rui_budget_fn step = rui_budgetStep[slot];
+        void *data = rui_budgetData[slot];
+        if (step && step(data) && rui_budgetStep[slot] == step && rui_budgetData[slot] == data) {
+            rui_budget_remove_slot(slot); // unless the step resubmitted or cancelled its own id
         }
-        input.cursor = input.length; // place cursor at end of text
+        now = GetTime();
+    } while (rui_budgetCount > rui_budgetDead && now - start < rui_budgetSeconds);
+    rui_budgetRunning = false;
+    if (rui_budgetDead > 0) { // close the gaps in order, keeping the round-robin position on the same job
+        int kept = 0;
+        int next = 0;
+        for (int i = 0; i < rui_budgetCount; ++i) {
+            if (!rui_budgetStep[i]) continue;
+            if (i < rui_budgetNext) next++;
+            rui_budgetId[kept] = rui_budgetId[i];
+            rui_budgetStep[kept] = rui_budgetStep[i];
+            rui_budgetData[kept] = rui_budgetData[i];
+            kept++;
+        }
+        rui_budgetCount = kept;
+        rui_budgetNext = next;
+        rui_budgetDead = 0;
     }
-    input.active = false; // start unfocused
-    input.blinkTimer = 0.0f; // reset blink timer
-    return input; // return initialized struct
+    rui_budgetUsed = now - start;
 }
 
-static void rui_text_input_set_cursor(rui_text_input *input, int position) { // helper to clamp cursor position
-    if (!input) return;
-    if (position < 0) position = 0;
-    if (position > input->length) position = input->length;
-    input->cursor = position;
+bool rui_budget_submit(unsigned int id, rui_budget_fn step, void *userData) {
+    if (!step || !rui_shared_owner()) return false; // the scheduler runs in the default context's frames
+    int slot = rui_budget_find(id);
+    if (slot < 0 && rui_budgetDead > 0) { // submitted from a step: refill a slot emptied this run
+        for (slot = 0; rui_budgetStep[slot]; ++slot) {}
+        rui_budgetDead--;
+        rui_budgetId[slot] = id;
+    }
+    if (slot < 0) {
+        if (rui_budgetCount >= RUI_BUDGET_MAX) return false;
+        slot = rui_budgetCount++;
+        rui_budgetId[slot] = id;
+    }
+    rui_budgetStep[slot] = step;
+    rui_budgetData[slot] = userData;
+    return true;
 }
 
-static void rui_text_input_insert_char(rui_text_input *input, int character) { // insert Unicode codepoint into buffer
-    if (!input || !input->buffer) return;
-    if (character == 0 || character == 127) return; // ignore null and delete key
-    if (character < 32) return; // skip non-printable control characters
-    if (input->length + 1 >= input->capacity) return; // avoid overflow
+bool rui_budget_pending(unsigned int id) {
+    return rui_ctx == &rui_contextDefault && rui_budget_find(id) >= 0;
+}
 
-    for (int i = input->length; i >= input->cursor; --i) { // shift characters to make space
-        input->buffer[i + 1] = input->buffer[i];
-    }
+void rui_budget_cancel(unsigned int id) {
+    if (!rui_shared_owner()) return;
+    int slot = rui_budget_find(id);
+    if (slot >= 0) rui_budget_remove_slot(slot);
+}
 
-    input->buffer[input->cursor] = (char)character; // insert character at cursor
-    input->length++;
-    rui_text_input_set_cursor(input, input->cursor + 1); // advance cursor
+void rui_budget_set(int microseconds) {
+    if (!rui_shared_owner()) return;
+    rui_budgetSeconds = (microseconds > 0 ? microseconds : 0) * 1e-6;
 }
 
-static void rui_text_input_backspace(rui_text_input *input) { // handle backspace deletion
-    if (!input || input->cursor <= 0) return;
-    for (int i = input->cursor - 1; i <= input->length; ++i) { // shift characters left
-        input->buffer[i] = input->buffer[i + 1];
-    }
-    input->length--;
-    rui_text_input_set_cursor(input, input->cursor - 1); // move cursor back
+int rui_budget_get(void) {
+    return (int)(rui_budgetSeconds * 1e6 + 0.5);
 }
 
-static void rui_text_input_delete(rui_text_input *input) { // handle delete key
-    if (!input || input->cursor >= input->length) return;
-    for (int i = input->cursor; i <= input->length; ++i) {
-        input->buffer[i] = input->buffer[i + 1];
-    }
-    input->length--;
+double rui_budget_used(void) {
+    return rui_budgetUsed;
 }
 
-static void rui_text_input_set_active(rui_text_input *input) { // centralize active input management
-    if (rui_activeTextInput && rui_activeTextInput != input) {
-        rui_activeTextInput->active = false; // deactivate previous input
+bool rui_budget_active(void) {
+    return rui_ctx == &rui_contextDefault && rui_budgetCount > rui_budgetDead;
+}
+
+// --- Change Events ---
+// A *_call widget under a coalescing policy only records its newest value here. rui_change_dispatch runs
+// once the frame's widgets are done and delivers each recorded value when its policy says so.
+void rui_change_next(rui_change_mode mode, float seconds) {
+    if (!rui_shared_owner()) return; // panel jobs and other contexts always call inline
+    rui_changeNextMode = mode;
+    rui_changeNextSeconds = seconds;
+    rui_changeNextSet = true;
+}
+
+void rui_change_default(rui_change_mode mode, float seconds) {
+    if (!rui_shared_owner()) return;
+    rui_changeDefaultMode = mode;
+    rui_changeDefaultSeconds = seconds;
+}
+
+static bool rui_change_post(rui_change_event event, bool changed) { // false: the caller runs the callback itself
+    if (!rui_shared_owner()) return false; // panel jobs and other contexts keep calling inline
+    rui_change_mode mode = rui_changeNextSet ? rui_changeNextMode : rui_changeDefaultMode;
+    float seconds = rui_changeNextSet ? rui_changeNextSeconds : rui_changeDefaultSeconds;
+    rui_changeNextSet = false; // consumed by this widget, with or without a callback
+    if (mode == RUI_CHANGE_IMMEDIATE) return false;
+
+    int slot = 0;
+    while (slot < rui_changeCount && !(rui_changes[slot].onFloat == event.onFloat && rui_changes[slot].onBool == event.onBool &&
+                                      rui_changes[slot].onText == event.onText && rui_changes[slot].userData == event.userData &&
+                                      rui_changes[slot].input == event.input && rui_changes[slot].widget == event.widget)) slot++;
+    if (slot == rui_changeCount) {
+        if (!changed && !event.held) return true; // nothing to remember yet
+        if (rui_changeCount == RUI_CHANGE_MAX) return false; // full: deliver now rather than drop
+        rui_changes[rui_changeCount++] = event; // firedAt 0: a throttled widget fires on its first change
     }
-    rui_activeTextInput = input; // store new active input (may be NULL)
-    rui_keyboardCaptured = (input != NULL); // update capture flag
-    if (input) input->active = true; // mark new input as active
+    rui_change_event *entry = &rui_changes[slot];
+    entry->mode = mode;
+    entry->seconds = seconds;
+    entry->frame = rui_changeFrame;
+    entry->held = event.held;
+    if (changed) {
+        entry->number = event.number;
+        entry->flag = event.flag;
+        entry->changedAt = GetTime();
+        entry->pending = true;
+    }
+    return true;
 }
 
-bool rui_text_input_box(Rectangle bounds, rui_text_input *input) { // draw text box and handle typing
-    if (!input || !input->buffer || input->capacity <= 1) return false;
+static unsigned int rui_change_widget(Rectangle bounds) { // identity of a widget drawn at absolute bounds
+    int cells[4] = { (int)floorf(bounds.x + 0.5f), (int)floorf(bounds.y + 0.5f), (int)floorf(bounds.width + 0.5f), (int)floorf(bounds.height + 0.5f) };
+    return rui_hash_bytes(cells, (int)sizeof(cells), 0);
+}
 
-    const rui_font_style *fs = &rui_themeCurrent.textFont;
+static unsigned int rui_change_panel_widget(void) { // identity of the next auto-layout widget: its content-space row in this panel
+    return rui_hash_int((int)floor(rui_layout->panelCursorY + 0.5), rui_layout->panelId);
+}
 
-    bool hovered = CheckCollisionPointRec(rui_mouse, bounds); // detect mouse over box
-    if (rui_mousePressed && hovered) { // focus when clicked
-        rui_text_input_set_active(input);
-        float relativeX = rui_mouse.x - bounds.x - 4.0f; // rough cursor placement
-        int caret = input->length;
-        float accumulated = 0.0f;
-        for (int i = 0; i < input->length; ++i) {
-            Vector2 glyph = MeasureTextEx(fs->font, (const char[]){input->buffer[i], '\0'}, (float)fs->size, fs->spacing);
-            float charWidth = glyph.x;
-            if (accumulated + charWidth * 0.5f >= relativeX) { caret = i; break; }
-            accumulated += charWidth;
+static void rui_change_float(void (*callback)(float, void *), void *userData, unsigned int widget, float value, bool changed, bool held) {
+    rui_change_event event = { 0 };
+    event.onFloat = callback;
+    event.userData = userData;
+    event.widget = widget;
+    event.number = value;
+    event.held = held;
+    if (!callback) { rui_change_post(event, false); return; } // still consumes rui_change_next
+    if (!rui_change_post(event, changed) && changed) callback(value, userData);
+}
+
+static void rui_change_bool(void (*callback)(bool, void *), void *userData, unsigned int widget, bool value, bool changed) {
+    rui_change_event event = { 0 };
+    event.onBool = callback;
+    event.userData = userData;
+    event.widget = widget;
+    event.flag = value;
+    if (!callback) { rui_change_post(event, false); return; }
+    if (!rui_change_post(event, changed) && changed) callback(value, userData);
+}
+
+static bool rui_change_due(const rui_change_event *event, double now) {
+    bool live = event->frame == rui_changeFrame; // its widget ran in the frame being finished
+    if (!live || !event->held) return true; // gesture over (or the widget went away): deliver the final value
+    if (event->mode == RUI_CHANGE_THROTTLE) return now - event->firedAt >= event->seconds;
+    if (event->mode == RUI_CHANGE_DEBOUNCE) return now - event->changedAt >= event->seconds;
+    return false; // on release: wait for the gesture to end
+}
+
+void rui_change_dispatch(void) {
+    if (!rui_shared_owner()) return; // callbacks run on the UI thread, from the default context's frames
+    double now = GetTime();
+    for (int i = 0; i < rui_changeCount;) {
+        rui_change_event *entry = &rui_changes[i];
+        if (entry->pending && rui_change_due(entry, now)) {
+            entry->pending = false;
+            entry->firedAt = now;
+            rui_change_event event = *entry; // the callback may start new widgets' events
+            if (event.onFloat) event.onFloat(event.number, event.userData);
+            else if (event.onBool) event.onBool(event.flag, event.userData);
+            else if (event.onText) event.onText(event.input ? event.input->buffer : "", event.userData);
+            entry = &rui_changes[i];
         }
-        rui_text_input_set_cursor(input, caret);
-    } else if (rui_mousePressed && !hovered) {
-        if (rui_activeTextInput == input) { // clicking elsewhere defocuses
-            input->active = false;
-            rui_text_input_set_active(NULL);
+        if (!entry->pending && (entry->frame != rui_changeFrame || !entry->held)) { // gesture over and delivered: free the slot
+            rui_changes[i] = rui_changes[--rui_changeCount];
+            continue;
         }
+        i++;
     }
+}
 
-    bool changed = false;
-    if (rui_activeTextInput == input) { // handle keyboard input only when active
-        int key = GetKeyPressed();
-        while (key > 0) { // process key presses
+bool rui_change_pending(void) {
+    if (rui_ctx != &rui_contextDefault) return false;
+    for (int i = 0; i < rui_changeCount; ++i) {
+        if (rui_changes[i].pending) return true;
+    }
+    return false;
+}
+
+static double rui_change_wakeup(void) { // seconds until a throttled or debounced event falls due, < 0 for none
+    double now = GetTime(), wake = -1.0;
+    for (int i = 0; i < rui_changeCount; ++i) {
+        const rui_change_event *entry = &rui_changes[i];
+        if (!entry->pending) continue;
+        double due = 0.0;
+        if (entry->held && entry->mode == RUI_CHANGE_THROTTLE) due = entry->firedAt + entry->seconds - now;
+        else if (entry->held && entry->mode == RUI_CHANGE_DEBOUNCE) due = entry->changedAt + entry->seconds - now;
+        else if (entry->held) continue; // on release: input ends the gesture
+        if (due < 0.0) due = 0.0;
+        if (wake < 0.0 || due < wake) wake = due;
+    }
+    return wake;
+}
+
+// --- Draw List ---
+static void *rui_grow(void *data, int *capacity, int needed, int elementSize) { // geometric growth; NULL keeps the old buffer
+    if (needed <= *capacity) return data;
+    int newCapacity = *capacity > 0 ? *capacity : 64;
+    while (newCapacity < needed) newCapacity *= 2;
+    void *grown = rui_realloc(data, (size_t)newCapacity * (size_t)elementSize);
+    if (!grown) return NULL;
+    *capacity = newCapacity;
+    return grown;
+}
+
+static void rui_draw_list_reset(rui_draw_list *list) { // keep the allocations, drop the contents
+    list->commandCount = 0;
+    list->textSize = 0;
+    list->fontCount = 0;
+    list->patchCount = 0;
+}
+
+void rui_draw_list_free(rui_draw_list *list) { // release all buffers owned by the list
+    if (!list) return;
+    rui_free(list->commands);
+    rui_free(list->text);
+    rui_free(list->fonts);
+    rui_free(list->patches);
+    *list = (rui_draw_list){0};
+}
+
+static bool rui_draw_recording(void) { // captures render straight into their texture and are never recorded
+    return rui_layout->drawRecordTarget != NULL && !rui_layout->panelCacheCapturing;
+}
+
+static bool rui_draw_executing(void) { // raylib calls are issued now unless recording for another thread
+    return rui_layout->drawExecute || rui_layout->panelCacheCapturing;
+}
+
+static int rui_draw_record(rui_draw_command command) { // append to the active list, returns the command index or -1
+    rui_draw_list *list = rui_layout->drawRecordTarget;
+    void *grown = rui_grow(list->commands, &list->commandCapacity, list->commandCount + 1, (int)sizeof(rui_draw_command));
+    if (!grown) return -1;
+    list->commands = (rui_draw_command *)grown;
+    list->commands[list->commandCount] = command;
+    return list->commandCount++;
+}
+
+static int rui_draw_rect(Rectangle rect, Color color) { // DrawRectangleRec through the draw list
+    if (rui_draw_executing()) DrawRectangleRec(rect, color);
+    if (!rui_draw_recording()) return -1;
+    rui_draw_command command = { .type = RUI_DRAW_RECT, .color = color, .rect = rect };
+    return rui_draw_record(command);
+}
+
+static int rui_draw_rect_lines(Rectangle rect, float thickness, Color color) { // DrawRectangleLinesEx through the draw list
+    if (rui_draw_executing()) DrawRectangleLinesEx(rect, thickness, color);
+    if (!rui_draw_recording()) return -1;
+    rui_draw_command command = { .type = RUI_DRAW_RECT_LINES, .color = color, .rect = rect };
+    command.as.thickness = thickness;
+    return rui_draw_record(command);
+}
+
+static int rui_draw_text(Font font, const char *text, Vector2 pos, float size, float spacing, Color color) { // DrawTextEx with the string copied into the list
+    if (rui_draw_executing()) DrawTextEx(font, text, pos, size, spacing, color);
+    if (!rui_draw_recording()) return -1;
+    rui_draw_list *list = rui_layout->drawRecordTarget;
+
+    int fontSlot = -1;
+    for (int i = 0; i < list->fontCount; ++i) { // few distinct fonts per frame, linear search is fine
+        if (list->fonts[i].texture.id == font.texture.id && list->fonts[i].glyphs == font.glyphs) { fontSlot = i; break; }
+    }
+    if (fontSlot < 0) {
+        void *grown = rui_grow(list->fonts, &list->fontCapacity, list->fontCount + 1, (int)sizeof(Font));
+        if (!grown) return -1;
+        list->fonts = (Font *)grown;
+        list->fonts[list->fontCount] = font;
+        fontSlot = list->fontCount++;
+    }
+
+    int length = (int)strlen(text) + 1;
+    void *grown = rui_grow(list->text, &list->textCapacity, list->textSize + length, 1);
+    if (!grown) return -1;
+    list->text = (char *)grown;
+    memcpy(list->text + list->textSize, text, (size_t)length);
+
+    rui_draw_command command = { .type = RUI_DRAW_TEXT, .color = color, .rect = { pos.x, pos.y, 0.0f, 0.0f } };
+    command.as.text.font = fontSlot;
+    command.as.text.size = size;
+    command.as.text.spacing = spacing;
+    command.as.text.offset = list->textSize;
+    list->textSize += length;
+    return rui_draw_record(command);
+}
+
+static void rui_draw_texture(Texture2D texture, Rectangle source, Vector2 pos, Color tint) { // premultiplied texture blit through the draw list (tint premultiplied too)
+    if (rui_draw_executing()) {
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        DrawTextureRec(texture, source, pos, tint);
+        EndBlendMode();
+    }
+    if (!rui_draw_recording()) return;
+    rui_draw_command command = { .type = RUI_DRAW_TEXTURE, .color = tint, .rect = { pos.x, pos.y, 0.0f, 0.0f } };
+    command.as.texture.texture = texture;
+    command.as.texture.source = source;
+    rui_draw_record(command);
+}
+
+static void rui_draw_scissor_begin(Rectangle area) { // scissor in render-target space (shifted while capturing)
+    if (rui_draw_executing()) {
+        BeginScissorMode((int)(area.x - rui_layout->drawOrigin.x),
+                         (int)(area.y - rui_layout->drawOrigin.y),
+                         (int)area.width,
+                         (int)area.height);
+    }
+    if (!rui_draw_recording()) return;
+    rui_draw_command command = { .type = RUI_DRAW_SCISSOR_BEGIN, .rect = area };
+    rui_draw_record(command);
+}
+
+static void rui_draw_scissor_end(void) { // EndScissorMode through the draw list
+    if (rui_draw_executing()) EndScissorMode();
+    if (!rui_draw_recording()) return;
+    rui_draw_command command = { .type = RUI_DRAW_SCISSOR_END };
+    rui_draw_record(command);
+}
+
+static void rui_draw_patch_add(int command, Rectangle hot, Color normal, Color hover, rui_text_input *input) { // remember how to refresh a command on replay
+    if (command < 0 || !rui_draw_recording()) return;
+    rui_draw_list *list = rui_layout->drawRecordTarget;
+    void *grown = rui_grow(list->patches, &list->patchCapacity, list->patchCount + 1, (int)sizeof(rui_draw_patch));
+    if (!grown) return;
+    list->patches = (rui_draw_patch *)grown;
+    list->patches[list->patchCount++] = (rui_draw_patch){ command, hot, normal, hover, input };
+}
+
+void rui_draw_list_submit(const rui_draw_list *list) { // replay commands in order
+    if (!list) return;
+    for (int i = 0; i < list->commandCount; ++i) {
+        const rui_draw_command *command = &list->commands[i];
+        switch (command->type) {
+            case RUI_DRAW_RECT:
+                DrawRectangleRec(command->rect, command->color);
+                break;
+            case RUI_DRAW_RECT_LINES:
+                DrawRectangleLinesEx(command->rect, command->as.thickness, command->color);
+                break;
+            case RUI_DRAW_TEXT:
+                DrawTextEx(list->fonts[command->as.text.font],
+                           list->text + command->as.text.offset,
+                           (Vector2){ command->rect.x, command->rect.y },
+                           command->as.text.size,
+                           command->as.text.spacing,
+                           command->color);
+                break;
+            case RUI_DRAW_TEXTURE:
+                BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+                DrawTextureRec(command->as.texture.texture, command->as.texture.source, (Vector2){ command->rect.x, command->rect.y }, command->color);
+                EndBlendMode();
+                break;
+            case RUI_DRAW_SCISSOR_BEGIN:
+                BeginScissorMode((int)command->rect.x, (int)command->rect.y, (int)command->rect.width, (int)command->rect.height);
+                break;
+            case RUI_DRAW_SCISSOR_END:
+                EndScissorMode();
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static unsigned int rui_draw_list_hash(const rui_draw_list *list, Rectangle *bounds) { // content hash and covered area of a list
+    unsigned int hash = 2166136261u;
+    bool any = false;
+    float left = 0.0f, top = 0.0f, right = 0.0f, bottom = 0.0f;
+    for (int i = 0; i < list->commandCount; ++i) {
+        const rui_draw_command *command = &list->commands[i];
+        hash = rui_hash_int((int)command->type, hash);
+        hash = rui_hash_bytes(&command->color, (int)sizeof(command->color), hash);
+        hash = rui_hash_bytes(&command->rect, (int)sizeof(command->rect), hash);
+        if (command->type == RUI_DRAW_TEXT) {
+            hash = rui_hash_string(list->text + command->as.text.offset, hash);
+            hash = rui_hash_float(command->as.text.size, hash);
+        } else if (command->type == RUI_DRAW_RECT_LINES) {
+            hash = rui_hash_float(command->as.thickness, hash);
+        }
+        if (command->type != RUI_DRAW_RECT && command->type != RUI_DRAW_RECT_LINES) continue; // panels always start with their body rect
+        Rectangle r = command->rect;
+        if (!any) { left = r.x; top = r.y; right = r.x + r.width; bottom = r.y + r.height; any = true; continue; }
+        left = fminf(left, r.x);
+        top = fminf(top, r.y);
+        right = fmaxf(right, r.x + r.width);
+        bottom = fmaxf(bottom, r.y + r.height);
+    }
+    *bounds = (Rectangle){ left, top, right - left, bottom - top };
+    return hash;
+}
+
+static void rui_draw_list_append(rui_draw_list *dst, const rui_draw_list *src) { // copy src to the end of dst, remapping fonts, text and patches
+    int commandBase = dst->commandCount;
+    int textBase = dst->textSize;
+    void *grown = rui_grow(dst->commands, &dst->commandCapacity, dst->commandCount + src->commandCount, (int)sizeof(rui_draw_command));
+    if (!grown) return;
+    dst->commands = (rui_draw_command *)grown;
+    grown = rui_grow(dst->text, &dst->textCapacity, dst->textSize + src->textSize, 1);
+    if (!grown) return;
+    dst->text = (char *)grown;
+    if (src->textSize > 0) memcpy(dst->text + dst->textSize, src->text, (size_t)src->textSize);
+    dst->textSize += src->textSize;
+
+    for (int i = 0; i < src->commandCount; ++i) {
+        rui_draw_command command = src->commands[i];
+        if (command.type == RUI_DRAW_TEXT) {
+            Font font = src->fonts[command.as.text.font];
+            int fontSlot = -1;
+            for (int f = 0; f < dst->fontCount; ++f) {
+                if (dst->fonts[f].texture.id == font.texture.id && dst->fonts[f].glyphs == font.glyphs) { fontSlot = f; break; }
+            }
+            if (fontSlot < 0) {
+                grown = rui_grow(dst->fonts, &dst->fontCapacity, dst->fontCount + 1, (int)sizeof(Font));
+                if (!grown) continue;
+                dst->fonts = (Font *)grown;
+                dst->fonts[dst->fontCount] = font;
+                fontSlot = dst->fontCount++;
+            }
+            command.as.text.font = fontSlot;
+            command.as.text.offset += textBase;
+        }
+        dst->commands[dst->commandCount++] = command;
+    }
+
+    grown = rui_grow(dst->patches, &dst->patchCapacity, dst->patchCount + src->patchCount, (int)sizeof(rui_draw_patch));
+    if (!grown) return;
+    dst->patches = (rui_draw_patch *)grown;
+    for (int i = 0; i < src->patchCount; ++i) {
+        rui_draw_patch patch = src->patches[i];
+        patch.command += commandBase;
+        dst->patches[dst->patchCount++] = patch;
+    }
+}
+
+static bool rui_color_equal(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+static void rui_draw_replay(void) { // refresh hover/caret colours and resubmit the recorded frame
+    rui_draw_list *list = &rui_drawListRecorded;
+    for (int i = 0; i < list->patchCount; ++i) {
+        const rui_draw_patch *patch = &list->patches[i];
+        rui_draw_command *command = &list->commands[patch->command];
+        bool on;
+        if (patch->input) { // caret: visible while its input is focused and in the "on" half of the blink
+            on = rui_ctx->activeTextInput == patch->input && fmodf(patch->input->blinkTimer, 1.0f) < 0.5f;
+        } else {
+            on = CheckCollisionPointRec(rui_ctx->mouse, patch->hot);
+        }
+        Color color = on ? patch->hover : patch->normal;
+        if (!rui_color_equal(color, command->color)) {
+            rui_layout->activity = true; // hover changed, same as a rebuilt frame would report
+            if (rui_damageEnabled) rui_damage_add(patch->input ? command->rect : patch->hot);
+            command->color = color;
+        }
+    }
+    rui_draw_list_submit(list);
+}
+
+rui_theme rui_theme_default(void) { // expose default theme values
+    rui_theme theme = RUI_THEME_DEFAULT;
+    Font defaultFont = GetFontDefault();
+    theme.textFont.font = defaultFont;
+    theme.textFont.size = 20;
+    theme.textFont.spacing = 1.0f;
+    theme.titleFont = theme.textFont;
+    theme.titleFont.size = 18;
+    return theme;
+}
+
+static void rui_apply_font_defaults(rui_font_style *style, const rui_font_style *fallback) {
+    if (style->font.texture.id == 0) {
+        style->font = fallback ? fallback->font : GetFontDefault();
+    }
+    if (style->size <= 0) {
+        style->size = fallback ? fallback->size : 20;
+    }
+    if (style->spacing == 0.0f) {
+        style->spacing = fallback ? fallback->spacing : 1.0f;
+    }
+}
+
+static Font (*rui_fontProvider)(const rui_font_style *style, int pixelSize, void *userData) = NULL; // bakes fonts for scaled sizes
+static void *rui_fontProviderData = NULL; // passed back to rui_fontProvider
+static void (*rui_fontRelease)(Font font, void *userData) = NULL; // takes back fonts rui_fontProvider returned
+
+static void rui_metrics_font_release(rui_font_style *resolved, bool *baked) { // hand a provider atlas back once nothing resolves to it
+    if (!*baked) return;
+    *baked = false;
+    if (rui_fontRelease) rui_fontRelease(resolved->font, rui_fontProviderData);
+    resolved->font = (Font){0};
+}
+
+static void rui_metrics_font(const rui_font_style *base, float scale, rui_font_style *resolved, unsigned int *key, bool *baked) { // scaled size, provider atlas
+    int pixelSize = (int)(base->size * scale + 0.5f);
+    if (pixelSize < 1) pixelSize = 1;
+    unsigned int newKey = rui_hash_int(pixelSize, rui_hash_font(base, 0));
+    if (*key == newKey && resolved->font.texture.id != 0) return; // same font and size: keep the atlas already chosen
+    *key = newKey;
+    rui_metrics_font_release(resolved, baked);
+    resolved->font = base->font;
+    resolved->size = pixelSize;
+    resolved->spacing = base->spacing * scale;
+    if (rui_fontProvider && scale != 1.0f) {
+        Font font = rui_fontProvider(base, pixelSize, rui_fontProviderData);
+        if (font.texture.id != 0) {
+            resolved->font = font;
+            *baked = true;
+        }
+    }
+}
+
+static void rui_metrics_build(rui_metrics *m, const rui_theme *theme, float requested) { // every scaled size for one theme and scale
+    float scale = requested > 0.0f ? requested : 1.0f;
+    m->scale = requested;
+    m->padding = 8.0f * scale;
+    m->spacing = 6.0f * scale;
+    m->headerPadding = 6.0f * scale;
+    m->minHeaderHeight = 18.0f * scale;
+    m->border = fmaxf(1.0f, roundf(2.0f * scale)); // whole pixels keep outlines crisp, never below one
+    m->hairline = fmaxf(1.0f, roundf(scale));
+    m->scrollbarWidth = 12.0f * scale;
+    m->scrollbarThumb = 8.0f * scale;
+    m->scrollbarInset = 10.0f * scale;
+    m->scrollStep = 20.0f * scale;
+    m->knobSize = 12.0f * scale;
+    m->trackHeight = 6.0f * scale;
+    m->closeButton = 18.0f * scale;
+    m->textInset = 4.0f * scale;
+    m->caretWidth = fmaxf(1.0f, roundf(2.0f * scale));
+    m->toggleGap = 8.0f * scale;
+    m->toggleInset = 3.0f * scale;
+    m->minToggleHeight = 24.0f * scale;
+    m->togglePadding = 8.0f * scale;
+    rui_metrics_font(&theme->textFont, scale, &m->textFont, &m->textFontKey, &m->textFontBaked);
+    rui_metrics_font(&theme->titleFont, scale, &m->titleFont, &m->titleFontKey, &m->titleFontBaked);
+}
+
+// --- Skins ---
+// A skin is a resolved theme plus the metrics built from it at one scale. Contexts with the same theme and
+// scale point at the same skin, so a context carries one pointer instead of its own colours, sizes and
+// font atlases. A skin never changes while contexts use it: a theme or scale change moves the context to
+// another one, so panel jobs and contexts on other threads read it without a lock.
+static bool rui_font_same(const rui_font_style *a, const rui_font_style *b) { // the fields rui_hash_font covers
+    return a->font.texture.id == b->font.texture.id && a->size == b->size && a->spacing == b->spacing;
+}
+
+static bool rui_theme_same(const rui_theme *a, const rui_theme *b) { // the fields rui_hash_theme covers
+    return memcmp(&a->panel, &b->panel, sizeof(a->panel)) == 0 && memcmp(&a->button, &b->button, sizeof(a->button)) == 0 &&
+           memcmp(&a->slider, &b->slider, sizeof(a->slider)) == 0 && memcmp(&a->toggle, &b->toggle, sizeof(a->toggle)) == 0 &&
+           memcmp(&a->textInput, &b->textInput, sizeof(a->textInput)) == 0 &&
+           rui_font_same(&a->textFont, &b->textFont) && rui_font_same(&a->titleFont, &b->titleFont);
+}
+
+static void rui_skin_drop(rui_skin *skin) { // one context less; the last one hands provider fonts back (caller holds rui_skinMutex)
+    if (--skin->refs > 0) return;
+    rui_metrics_font_release(&skin->metrics.textFont, &skin->metrics.textFontBaked);
+    rui_metrics_font_release(&skin->metrics.titleFont, &skin->metrics.titleFontBaked);
+}
+
+static void rui_skin_use(const rui_theme *theme) { // point the current context at the skin for theme at its scale
+    float scale = rui_ctx->scale > 0.0f ? rui_ctx->scale : 1.0f;
+    unsigned int hash = rui_hash_float(scale, rui_hash_theme(theme));
+    rui_skin *old = rui_ctx->skin, *skin = NULL, *spare = NULL;
+#ifdef RUI_THREADS
+    pthread_mutex_lock(&rui_skinMutex);
+#endif
+    for (int i = 0; i < RUI_SKIN_MAX && !skin; ++i) {
+        rui_skin *candidate = &rui_skins[i];
+        if (candidate->refs == 0) {
+            if (!spare) spare = candidate;
+        } else if (candidate->hash == hash && candidate->scale == rui_ctx->scale && rui_theme_same(&candidate->theme, theme)) {
+            skin = candidate;
+        }
+    }
+    if (!skin && spare) { // first context with this theme and scale: build its skin (theme may point into old, which is still held)
+        skin = spare;
+        skin->theme = *theme;
+        skin->metrics = (rui_metrics){0};
+        skin->scale = rui_ctx->scale;
+        skin->hash = hash;
+        rui_metrics_build(&skin->metrics, &skin->theme, skin->scale);
+    }
+    if (!skin && !old) skin = &rui_skins[0]; // pool full and nothing to keep: share any skin rather than have none
+    if (skin) skin->refs++;
+    if (skin && old) rui_skin_drop(old); // after the new skin holds its reference, so old == skin keeps its fonts
+#ifdef RUI_THREADS
+    pthread_mutex_unlock(&rui_skinMutex);
+#endif
+    if (skin && skin != old && old && rui_ctx == &rui_contextDefault) rui_draw_list_reset(&rui_drawListRecorded); // the replayed frame has the old look: rebuild next tick
+    if (skin) rui_ctx->skin = skin;
+}
+
+static void rui_skin_release(rui_context *ctx) { // drop ctx's share of its skin
+    if (!ctx->skin) return;
+#ifdef RUI_THREADS
+    pthread_mutex_lock(&rui_skinMutex);
+#endif
+    rui_skin_drop(ctx->skin);
+#ifdef RUI_THREADS
+    pthread_mutex_unlock(&rui_skinMutex);
+#endif
+    ctx->skin = NULL;
+}
+
+void rui_set_scale(float scale) { // e.g. GetWindowScaleDPI().x
+    rui_ctx->scale = scale > 0.0f ? scale : 1.0f;
+    if (rui_ctx->skin) rui_skin_use(&rui_ctx->skin->theme); // otherwise built with the theme on the first frame
+}
+
+float rui_get_scale(void) {
+    return rui_ctx->scale;
+}
+
+const rui_metrics *rui_get_metrics(void) {
+    static const rui_metrics none = {0}; // before the first frame
+    return rui_ctx->skin ? &rui_ctx->skin->metrics : &none;
+}
+
+void rui_set_font_provider(Font (*provider)(const rui_font_style *style, int pixelSize, void *userData), void *userData) { // applies from the next scale or theme change
+    rui_fontProvider = provider;
+    rui_fontProviderData = userData;
+}
+
+void rui_set_font_release(void (*release)(Font font, void *userData)) { // e.g. a wrapper around UnloadFont
+    rui_fontRelease = release;
+}
+
+void rui_theme_set(const rui_theme *theme) { // replace current theme
+    if (!theme) return;
+    rui_theme resolved = *theme;
+
+    rui_apply_font_defaults(&resolved.textFont, NULL);
+    rui_apply_font_defaults(&resolved.titleFont, &resolved.textFont);
+
+    rui_ctx->panelStyleDefault = resolved.panel;
+    rui_skin_use(&resolved); // fonts may have changed, so another skin resolves them
+}
+
+void rui_theme_set_ctx(rui_context *ctx, const rui_theme *theme) { // theme_set on another context without switching to it
+    rui_context *previous = rui_context_set(ctx);
+    rui_theme_set(theme);
+    rui_context_set(previous);
+}
+
+const rui_theme *rui_theme_get(void) { // access current theme pointer
+    return rui_ctx->skin ? &rui_ctx->skin->theme : &RUI_THEME_DEFAULT; // defaults (fonts unresolved) before the first frame
+}
+
+void rui_theme_reset(void) { // restore default theme
+    rui_theme theme = rui_theme_default();
+    rui_theme_set(&theme);
+    rui_layout->alphaStack[0] = 1.0f;
+    rui_layout->alphaTop = 0;
+    rui_layout->alphaCurrent = 1.0f;
+}
+
+void rui_set_default_panel_style(rui_panel_style style) { // override default panel style independent of theme
+    rui_ctx->panelStyleDefault = style;
+}
+
+rui_panel_style rui_get_default_panel_style(void) { // read current default panel style
+    return rui_ctx->panelStyleDefault;
+}
+
+static void rui_frame_input(void) { // per-frame input and animation state shared by rebuilt and replayed frames
+    if (!rui_ctx->skin) {
+        rui_theme_reset();
+    }
+    if (rui_ctx->skin->scale != rui_ctx->scale) rui_skin_use(&rui_ctx->skin->theme); // scale set directly on the context
+
+    Vector2 mouse = rui_ctx->pointerOverride ? rui_ctx->pointer : GetMousePosition(); // cache mouse coordinates in this context's space
+    rui_ctx->mouse.x = (mouse.x - rui_ctx->inputOffset.x) * (rui_ctx->inputScale.x != 0.0f ? rui_ctx->inputScale.x : 1.0f);
+    rui_ctx->mouse.y = (mouse.y - rui_ctx->inputOffset.y) * (rui_ctx->inputScale.y != 0.0f ? rui_ctx->inputScale.y : 1.0f);
+    rui_ctx->mousePressed = IsMouseButtonPressed(MOUSE_LEFT_BUTTON); // see if left button pressed
+    if (rui_ctx->pointerOverride && !rui_ctx->pointerInside) { // pointing elsewhere: nothing hovers, clicks belong to someone else
+        rui_ctx->mouse = (Vector2){ -100000.0f, -100000.0f };
+        rui_ctx->mousePressed = false;
+    }
+    rui_ctx->popupMouse = rui_ctx->mouse; // popups always see the real pointer
+    rui_ctx->popupPressed = rui_ctx->mousePressed;
+    rui_ctx->popupRectPrev = rui_ctx->popupRect;
+    rui_ctx->popupRect = (Rectangle){ 0 };
+    if (CheckCollisionPointRec(rui_ctx->mouse, rui_ctx->popupRectPrev)) { // a popup covers the pointer: widgets underneath see nothing
+        rui_ctx->mouse = (Vector2){ -100000.0f, -100000.0f };
+        rui_ctx->mousePressed = false;
+    }
+    if (rui_ctx->popups) rui_draw_list_reset(rui_ctx->popups);
+    if (rui_ctx == &rui_contextDefault) { // process-wide bookkeeping follows the default context's frames
+        rui_change_dispatch(); // events of the previous frame's widgets, when nothing dispatched them yet
+        rui_changeFrame++;
+        rui_frameIndex++; // advance frame counter used by cache eviction
+        rui_alloc_begin_frame();
+        rui_budget_run(); // before widgets, so they show this frame's partial results
+    }
+    rui_ctx->frameDelta = GetFrameTime() + rui_ctx->pendingDelta; // frames woken from event waiting can report long gaps
+    rui_ctx->pendingDelta = 0.0f;
+    if (rui_ctx->frameDelta > RUI_MAX_FRAME_DELTA) rui_ctx->frameDelta = RUI_MAX_FRAME_DELTA;
+    if (rui_ctx == &rui_contextDefault) rui_tweens_update(rui_ctx->frameDelta); // this frame's clamped step
+    rui_layout->hoverHashPrev = rui_layout->hoverHash;
+    rui_layout->hoverHash = 0;
+    rui_layout->activity = rui_ctx->mousePressed || GetMouseWheelMove() != 0.0f; // clicks and wheel may change app state
+    if (rui_ctx == &rui_contextDefault && rui_jobs_poll() > 0) rui_layout->activity = true; // finished jobs change what busy buttons show
+
+    if (rui_ctx->fadeActive) { // advance fade animation when active
+        rui_ctx->fadeElapsed += rui_ctx->frameDelta; // accrue frame delta time
+        if (rui_ctx->fadeDuration <= 0.0f) { // handle zero duration edge case
+            rui_ctx->fadeAlpha = rui_ctx->fadeTargetAlpha; // jump straight to target alpha
+            rui_ctx->fadeActive = false; // stop animation immediately
+        } else {
+            float t = rui_ctx->fadeElapsed / rui_ctx->fadeDuration; // normalize elapsed time
+            if (t >= 1.0f) { // clamp when animation completes
+                t = 1.0f;
+                rui_ctx->fadeActive = false; // mark animation done
+            }
+            rui_ctx->fadeAlpha = rui_ctx->fadeStartAlpha + (rui_ctx->fadeTargetAlpha - rui_ctx->fadeStartAlpha) * t; // interpolate alpha
+        }
+    }
+
+}
+
+void rui_begin_frame(void) { // grab per-frame input state
+    rui_frame_input();
+    if (rui_ctx->activeCombo && !rui_ctx->activeComboDrawn) { // its widget stopped running (panel hidden, combo out of scope): give the keyboard back
+        rui_ctx->activeCombo = NULL; // not dereferenced: the combo may be gone, and it closes itself if drawn again
+        rui_ctx->keyboardCaptured = rui_ctx->activeTextInput != NULL;
+    }
+    rui_ctx->activeComboDrawn = false;
+    if (rui_damageEnabled && rui_ctx == &rui_contextDefault) rui_damage_begin_frame(true); // start a fresh damage list for this frame
+}
+
+void rui_set_tick_rate(float hz) { // choose how often widgets are rebuilt
+    rui_tickRate = hz > 0.0f ? hz : 0.0f;
+    rui_tickAccumulator = 0.0f;
+    if (rui_tickRate == 0.0f) rui_draw_list_free(&rui_drawListRecorded); // nothing left to replay
+}
+
+bool rui_frame_rebuild(void) { // rebuild widgets when due or when input arrives, otherwise replay the last frame
+    if (rui_tickRate <= 0.0f || rui_ctx != &rui_contextDefault) { // tick rate off (or another context, which has no replay list): every frame is a rebuild
+        rui_begin_frame();
+        return true;
+    }
+
+    float interval = 1.0f / rui_tickRate;
+    rui_tickAccumulator += GetFrameTime();
+    bool input = IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsMouseButtonDown(MOUSE_LEFT_BUTTON) ||
+                 IsMouseButtonReleased(MOUSE_LEFT_BUTTON) || GetMouseWheelMove() != 0.0f ||
+                 rui_ctx->keyboardCaptured; // clicks, drags, wheel and typing never wait for the next tick
+    bool animating = rui_tweenMoving > 0 || rui_ctx->fadeActive || rui_layout_scrolling(rui_layout); // a replayed frame would freeze them at the tick rate
+    if (input || animating || rui_tickAccumulator >= interval || rui_drawListRecorded.commandCount == 0) {
+        if (rui_tickAccumulator >= interval) rui_tickAccumulator = fmodf(rui_tickAccumulator, interval); // keep the average rate
+        rui_begin_frame();
+        rui_draw_list_reset(&rui_drawListRecorded);
+        rui_layout->drawRecordTarget = &rui_drawListRecorded; // draw now and keep a copy for replay
+        return true;
+    }
+
+    rui_frame_input();
+    if (rui_damageEnabled) rui_damage_begin_frame(false);
+    rui_layout->hoverHash = rui_layout->hoverHashPrev; // hover changes are reported through the patches instead
+    rui_ctx->popupRect = rui_ctx->popupRectPrev; // replayed popups still cover what they covered
+    if (rui_ctx->activeTextInput) { // no widget runs on replayed frames, so advance the caret blink here
+        rui_ctx->activeTextInput->blinkTimer += rui_ctx->frameDelta;
+        if (rui_ctx->activeTextInput->blinkTimer > 1.0f) rui_ctx->activeTextInput->blinkTimer -= 1.0f;
+    }
+    rui_draw_replay();
+    return false;
+}
+
+void rui_begin_frame_recorded(void) { // frame for another thread: record everything, draw nothing
+    rui_begin_frame();
+    if (rui_ctx != &rui_contextDefault) { // the handoff queue is the default context's; others record through rui_context_set_output
+        rui_layout->drawExecute = false;
+        return;
+    }
+    rui_draw_list_reset(&rui_frameQueue[rui_frameWrite]);
+    rui_layout->drawRecordTarget = &rui_frameQueue[rui_frameWrite];
+    rui_layout->drawExecute = false; // no GL on this thread (panel caching falls back to live recording)
+}
+
+void rui_end_frame(void) { // stop recording; publish recorded-only frames to the render thread
+    rui_draw_popups(); // no-op when the app already drew them
+    rui_change_dispatch(); // after every widget of the frame has run
+    if (!rui_layout->drawExecute && rui_layout->drawRecordTarget == &rui_frameQueue[rui_frameWrite]) {
+        int previous = RUI_ATOMIC_EXCHANGE(&rui_frameReady, rui_frameWrite | RUI_FRAME_FRESH); // never waits on the reader
+        rui_frameWrite = previous & 3; // reuse whichever slot the reader isn't holding
+    }
+    rui_layout->drawExecute = true;
+    rui_layout->drawRecordTarget = NULL;
+}
+
+const rui_draw_list *rui_frame_acquire(void) { // take the newest frame if one was published since the last call
+    if (RUI_ATOMIC_LOAD(&rui_frameReady) & RUI_FRAME_FRESH) {
+        int previous = RUI_ATOMIC_EXCHANGE(&rui_frameReady, rui_frameRead);
+        rui_frameRead = previous & 3;
+        rui_frameReadValid = true;
+    }
+    return rui_frameReadValid ? &rui_frameQueue[rui_frameRead] : NULL; // no new frame: resubmit the previous one
+}
+
+void rui_frame_queue_free(void) { // drop all handoff buffers (neither thread may be using them)
+    for (int i = 0; i < 3; ++i) rui_draw_list_free(&rui_frameQueue[i]);
+    rui_frameWrite = 0;
+    rui_frameReady = 1;
+    rui_frameRead = 2;
+    rui_frameReadValid = false;
+}
+
+// --- Contexts ---
+void rui_layout_init(rui_layout_state *layout) { // fresh layout with library defaults
+    if (layout) *layout = RUI_LAYOUT_DEFAULT;
+}
+
+void rui_context_init(rui_context *ctx) { // plain struct reset, no allocation
+    if (!ctx) return;
+    *ctx = (rui_context){0};
+    ctx->layout = RUI_LAYOUT_DEFAULT;
+    ctx->fadeColor = (Color){0, 0, 0, 255};
+    ctx->panelStyleDefault = RUI_THEME_DEFAULT.panel;
+    ctx->scale = 1.0f;
+}
+
+void rui_context_free(rui_context *ctx) {
+    if (!ctx) return;
+    if (ctx->popups) {
+        rui_draw_list_free(ctx->popups);
+        rui_free(ctx->popups);
+        ctx->popups = NULL;
+    }
+    rui_skin_release(ctx); // the theme is resolved again if the context is used after all
+}
+
+rui_context *rui_context_default(void) {
+    return &rui_contextDefault;
+}
+
+rui_context *rui_context_set(rui_context *ctx) { // swap the thread's current context
+    rui_context *previous = rui_ctx;
+    rui_ctx = ctx ? ctx : &rui_contextDefault;
+    rui_layout = &rui_ctx->layout;
+    return previous;
+}
+
+rui_context *rui_context_get(void) {
+    return rui_ctx;
+}
+
+void rui_context_set_input_transform(rui_context *ctx, Vector2 offset, Vector2 scale) { // e.g. a split-screen viewport origin
+    if (!ctx) return;
+    ctx->inputOffset = offset;
+    ctx->inputScale = scale;
+}
+
+void rui_context_set_output(rui_context *ctx, rui_draw_list *list) { // the owner submits list with rui_draw_list_submit
+    if (ctx) ctx->output = list;
+}
+
+void rui_begin_frame_ctx(rui_context *ctx) { // current until rui_end_frame_ctx
+    if (!ctx) ctx = &rui_contextDefault;
+    ctx->previous = rui_context_set(ctx);
+    rui_begin_frame();
+    if (ctx->output) {
+        rui_draw_list_reset(ctx->output);
+        rui_layout->drawRecordTarget = ctx->output;
+        rui_layout->drawExecute = false; // no raylib calls: safe on any thread
+    }
+}
+
+void rui_end_frame_ctx(rui_context *ctx) {
+    if (!ctx) ctx = &rui_contextDefault;
+    rui_end_frame();
+    rui_context_set(ctx->previous);
+    ctx->previous = NULL;
+}
+
+// --- Surfaces ---
+void rui_surface_init(rui_surface *surface, int width, int height) { // texture plus an independent context
+    if (!surface) return;
+    *surface = (rui_surface){0};
+    rui_context_init(&surface->context);
+    surface->context.pointerOverride = true; // input comes from rui_surface_set_pointer, not the window
+    surface->target = LoadRenderTexture(width, height);
+    surface->policy = RUI_SURFACE_EVERY_FRAME;
+    surface->interval = 1;
+    surface->visible = true;
+    surface->dirty = true; // first begin always draws
+}
+
+void rui_surface_unload(rui_surface *surface) {
+    if (!surface) return;
+    if (surface->target.id != 0) UnloadRenderTexture(surface->target);
+    surface->target = (RenderTexture2D){0};
+    rui_context_free(&surface->context);
+}
+
+void rui_surface_set_policy(rui_surface *surface, rui_surface_policy policy, int interval) {
+    if (!surface) return;
+    surface->policy = policy;
+    surface->interval = interval > 0 ? interval : 1;
+}
+
+void rui_surface_set_pointer(rui_surface *surface, Vector2 texel, bool inside) { // call each frame before rui_surface_begin
+    if (!surface) return;
+    surface->context.pointer = texel;
+    surface->context.pointerInside = inside;
+}
+
+bool rui_surface_pointer_from_ray(rui_surface *surface, Ray ray, Vector3 topLeft, Vector3 topRight, Vector3 bottomRight, Vector3 bottomLeft) { // hit point projected onto the quad edges
+    if (!surface) return false;
+    RayCollision hit = GetRayCollisionQuad(ray, topLeft, topRight, bottomRight, bottomLeft);
+    if (!hit.hit) {
+        rui_surface_set_pointer(surface, surface->context.pointer, false);
+        return false;
+    }
+    Vector3 across = Vector3Subtract(topRight, topLeft);
+    Vector3 down = Vector3Subtract(bottomLeft, topLeft);
+    Vector3 local = Vector3Subtract(hit.point, topLeft);
+    float acrossLength = Vector3DotProduct(across, across);
+    float downLength = Vector3DotProduct(down, down);
+    float u = acrossLength > 0.0f ? Vector3DotProduct(local, across) / acrossLength : 0.0f; // exact for rectangular screens
+    float v = downLength > 0.0f ? Vector3DotProduct(local, down) / downLength : 0.0f;
+    Vector2 texel = { u * (float)surface->target.texture.width, v * (float)surface->target.texture.height };
+    rui_surface_set_pointer(surface, texel, true);
+    return true;
+}
+
+static bool rui_surface_due(rui_surface *surface) { // apply the update policy
+    if (!surface->visible || surface->target.id == 0) return false;
+    if (surface->dirty || surface->policy == RUI_SURFACE_EVERY_FRAME) return true;
+    rui_context *ctx = &surface->context;
+    bool pointed = ctx->pointerInside || surface->pointerInsidePrev; // entering and leaving both change hover
+    bool moved = ctx->pointerInside != surface->pointerInsidePrev ||
+                 ctx->pointer.x != surface->pointerPrev.x || ctx->pointer.y != surface->pointerPrev.y;
+    bool input = pointed && (moved || IsMouseButtonDown(MOUSE_LEFT_BUTTON) || IsMouseButtonReleased(MOUSE_LEFT_BUTTON) ||
+                             GetMouseWheelMove() != 0.0f);
+    if (input || surface->wantsUpdate || ctx->keyboardCaptured) return true; // interaction never waits
+    if (surface->policy == RUI_SURFACE_EVERY_N) return surface->framesSkipped + 1 >= surface->interval;
+    return false;
+}
+
+bool rui_surface_begin(rui_surface *surface) { // skipped frames cost neither UI time nor fill rate
+    if (!surface) return false;
+    if (!rui_surface_due(surface)) {
+        surface->framesSkipped++;
+        surface->context.pendingDelta += GetFrameTime(); // fades and caret catch up on the next update
+        return false;
+    }
+    surface->framesSkipped = 0;
+    surface->dirty = false;
+    surface->updating = true;
+    surface->pointerPrev = surface->context.pointer;
+    surface->pointerInsidePrev = surface->context.pointerInside;
+    BeginTextureMode(surface->target);
+    ClearBackground(BLANK);
+    rui_begin_frame_ctx(&surface->context);
+    return true;
+}
+
+void rui_surface_end(rui_surface *surface) {
+    if (!surface || !surface->updating) return;
+    surface->wantsUpdate = rui_needs_redraw(); // still evaluated in the surface's context
+    rui_end_frame_ctx(&surface->context);
+    EndTextureMode();
+    surface->updating = false;
+}
+
+// --- Panel Jobs ---
+
+#ifdef RUI_THREADS
+typedef struct rui_task { // unit of work for the pool
+    void (*run)(void *arg);
+    void *arg;
+    int *pending; // counter decremented when the task finishes
+} rui_task;
+
+static pthread_mutex_t rui_taskMutex = PTHREAD_MUTEX_INITIALIZER; // guards the queue and every pending counter
+static pthread_cond_t rui_taskAvailable = PTHREAD_COND_INITIALIZER; // signalled when tasks are queued or on shutdown
+static pthread_cond_t rui_taskDone = PTHREAD_COND_INITIALIZER; // signalled when a pending counter reaches zero
+static rui_task rui_taskQueue[RUI_TASK_QUEUE_SIZE]; // ring buffer of queued tasks
+static int rui_taskHead = 0; // index of the oldest queued task
+static int rui_taskCount = 0; // number of queued tasks
+static pthread_t rui_workers[RUI_WORKER_COUNT]; // pool threads
+static int rui_workerCount = 0; // threads actually started
+static bool rui_workersQuit = false; // tells workers to exit once the queue drains
+
+static void rui_task_finish(int *pending) { // called with the mutex held
+    --*pending;
+    pthread_cond_broadcast(&rui_taskDone); // waiters recheck their own counter or flag
+}
+
+static bool rui_task_take(int *pending, rui_task *task) { // called with the mutex held: oldest task counted by pending (any task when NULL)
+    for (int i = 0; i < rui_taskCount; ++i) {
+        if (pending && rui_taskQueue[(rui_taskHead + i) % RUI_TASK_QUEUE_SIZE].pending != pending) continue;
+        *task = rui_taskQueue[(rui_taskHead + i) % RUI_TASK_QUEUE_SIZE];
+        for (int k = i; k > 0; --k) { // close the gap: the tasks queued before it move up one slot
+            rui_taskQueue[(rui_taskHead + k) % RUI_TASK_QUEUE_SIZE] = rui_taskQueue[(rui_taskHead + k - 1) % RUI_TASK_QUEUE_SIZE];
+        }
+        rui_taskHead = (rui_taskHead + 1) % RUI_TASK_QUEUE_SIZE;
+        rui_taskCount--;
+        return true;
+    }
+    return false;
+}
+
+static void *rui_worker_main(void *unused) { // pull tasks until shutdown
+    (void)unused;
+    pthread_mutex_lock(&rui_taskMutex);
+    for (;;) {
+        while (rui_taskCount == 0 && !rui_workersQuit) pthread_cond_wait(&rui_taskAvailable, &rui_taskMutex);
+        rui_task task;
+        if (!rui_task_take(NULL, &task)) break; // quitting and nothing left
+        pthread_mutex_unlock(&rui_taskMutex);
+        task.run(task.arg);
+        pthread_mutex_lock(&rui_taskMutex);
+        rui_task_finish(task.pending);
+    }
+    pthread_mutex_unlock(&rui_taskMutex);
+    return NULL;
+}
+
+static bool rui_task_try_submit(void (*run)(void *arg), void *arg, int *pending) { // queue a task; false when the queue is full
+    pthread_mutex_lock(&rui_taskMutex);
+    if (rui_workerCount == 0 && !rui_workersQuit) { // start the pool on first use
+        for (int i = 0; i < RUI_WORKER_COUNT; ++i) {
+            if (pthread_create(&rui_workers[rui_workerCount], NULL, rui_worker_main, NULL) == 0) rui_workerCount++;
+        }
+    }
+    if (rui_workerCount == 0) { // no threads could start: behave as a build without RUI_THREADS
+        pthread_mutex_unlock(&rui_taskMutex);
+        run(arg);
+        return true;
+    }
+    if (rui_taskCount == RUI_TASK_QUEUE_SIZE) {
+        pthread_mutex_unlock(&rui_taskMutex);
+        return false;
+    }
+    rui_taskQueue[(rui_taskHead + rui_taskCount) % RUI_TASK_QUEUE_SIZE] = (rui_task){ run, arg, pending };
+    rui_taskCount++;
+    (*pending)++;
+    pthread_cond_signal(&rui_taskAvailable);
+    pthread_mutex_unlock(&rui_taskMutex);
+    return true;
+}
+
+static void rui_task_submit(void (*run)(void *arg), void *arg, int *pending) { // queue a task, or run it inline when the queue is full
+    if (!rui_task_try_submit(run, arg, pending)) run(arg);
+}
+
+static void rui_task_wait_flag(int *flag) { // sleep until a task sets *flag; never runs queued work
+    pthread_mutex_lock(&rui_taskMutex);
+    while (!RUI_ATOMIC_LOAD(flag)) pthread_cond_wait(&rui_taskDone, &rui_taskMutex); // tasks broadcast as they finish
+    pthread_mutex_unlock(&rui_taskMutex);
+}
+
+static void rui_task_wait(int *pending) { // help with our own queued tasks until every task counted by pending is done
+    pthread_mutex_lock(&rui_taskMutex);
+    while (*pending > 0) {
+        rui_task task;
+        if (rui_task_take(pending, &task)) { // only tasks counted by pending: someone else's slow job never lands on this thread
+            pthread_mutex_unlock(&rui_taskMutex);
+            task.run(task.arg);
+            pthread_mutex_lock(&rui_taskMutex);
+            rui_task_finish(task.pending);
+        } else {
+            pthread_cond_wait(&rui_taskDone, &rui_taskMutex);
+        }
+    }
+    pthread_mutex_unlock(&rui_taskMutex);
+}
+
+void rui_workers_shutdown(void) { // drain the queue and join every worker
+    pthread_mutex_lock(&rui_taskMutex);
+    rui_workersQuit = true;
+    pthread_cond_broadcast(&rui_taskAvailable);
+    int count = rui_workerCount;
+    pthread_mutex_unlock(&rui_taskMutex);
+    for (int i = 0; i < count; ++i) pthread_join(rui_workers[i], NULL);
+    pthread_mutex_lock(&rui_taskMutex);
+    rui_workerCount = 0;
+    rui_workersQuit = false; // the pool restarts on the next submit
+    pthread_mutex_unlock(&rui_taskMutex);
+}
+#else
+static bool rui_task_try_submit(void (*run)(void *arg), void *arg, int *pending) { // no threads: run immediately
+    (void)pending;
+    run(arg);
+    return true;
+}
+
+static void rui_task_submit(void (*run)(void *arg), void *arg, int *pending) {
+    rui_task_try_submit(run, arg, pending);
+}
+
+static void rui_task_wait_flag(int *flag) { // tasks ran inline, so the flag is already set
+    (void)flag;
+}
+
+static void rui_task_wait(int *pending) { // nothing is ever outstanding
+    (void)pending;
+}
+
+void rui_workers_shutdown(void) { // nothing to stop
+}
+#endif
+
+// --- Async Jobs ---
+// A job's callback runs on the pool and its last write is the atomic state store, so the UI thread can
+// retire it with one load per running job and no lock. Once the callback has returned the pool only
+// touches rui_jobPending, never the job, so the app may reuse or free it as soon as it reads idle.
+
+static rui_job *rui_jobActive = NULL; // running jobs (started this frame or earlier)
+static int rui_jobPending = 0; // pool counter shared by every job, for rui_jobs_wait
+#ifdef RUI_THREADS
+static pthread_mutex_t rui_jobMutex = PTHREAD_MUTEX_INITIALIZER; // panel jobs may start jobs concurrently
+#endif
+
+static void rui_job_task(void *arg) { // pool side
+    rui_job *job = (rui_job *)arg;
+    job->callback(job->userData);
+    RUI_ATOMIC_STORE(&job->state, 2); // publishes to rui_jobs_poll; the job is not touched after this
+}
+
+bool rui_job_start(rui_job *job, void (*callback)(void *), void *userData) {
+    if (!job || !callback || job->state != 0) return false;
+    job->callback = callback;
+    job->userData = userData;
+    job->state = 1;
+#ifdef RUI_THREADS
+    pthread_mutex_lock(&rui_jobMutex);
+#endif
+    job->next = rui_jobActive;
+    rui_jobActive = job;
+#ifdef RUI_THREADS
+    pthread_mutex_unlock(&rui_jobMutex);
+#endif
+    rui_layout->activity = true;
+    if (!rui_task_try_submit(rui_job_task, job, &rui_jobPending)) job->state = 3; // queue full: rui_jobs_poll retries, the UI thread never runs it
+    return true; // without RUI_THREADS the callback has already run; the next poll reports it
+}
+
+bool rui_job_busy(const rui_job *job) {
+    return job && job->state != 0;
+}
+
+bool rui_job_done(const rui_job *job) {
+    return job && job->runs > 0 && job->doneFrame == rui_changeFrame;
+}
+
+int rui_jobs_poll(void) { // UI thread, between frames: nothing starts jobs while the list is walked
+    int finished = 0;
+    rui_job **link = &rui_jobActive;
+    while (*link) {
+        rui_job *job = *link;
+        if (job->state == 3) { // not handed to the pool yet, so no worker can write state
+            job->state = 1;
+            if (!rui_task_try_submit(rui_job_task, job, &rui_jobPending)) job->state = 3;
+        }
+        if (RUI_ATOMIC_LOAD(&job->state) != 2) {
+            link = &job->next;
+            continue;
+        }
+        *link = job->next; // unlink first: done may start the job again, which pushes it at the head
+        job->next = NULL;
+        job->state = 0;
+        job->runs++;
+        job->doneFrame = rui_changeFrame;
+        finished++;
+        if (job->done) job->done(job->userData);
+    }
+    return finished;
+}
+
+void rui_jobs_wait(void) { // an explicit wait, so the caller may run job callbacks itself
+    for (rui_job *job = rui_jobActive; job; job = job->next) {
+        if (job->state == 3) { // never got into the queue
+            job->state = 1;
+            rui_job_task(job);
+        }
+    }
+    rui_task_wait(&rui_jobPending); // helps with queued job callbacks only
+    rui_jobs_poll();
+}
+
+static void rui_button_busy(const char *text, Rectangle bounds) { // a button whose job is still running: no clicks, moving bar
+    const rui_button_style *bs = &rui_ctx->skin->theme.button;
+    rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, bounds)); // still counts as hovered, but never pressed
+    rui_draw_rect(bounds, rui_apply_alpha(bs->pressed));
+    rui_draw_rect_lines(bounds, rui_ctx->skin->metrics.border, rui_apply_alpha(bs->border));
+
+    float barHeight = rui_ctx->skin->metrics.border * 2.0f;
+    float barWidth = bounds.width / 3.0f;
+    int phase = (int)(GetTime() * 60.0) % 120; // one sweep there and back every two seconds
+    float t = (float)(phase < 60 ? phase : 120 - phase) / 60.0f;
+    rui_draw_rect((Rectangle){ bounds.x + (bounds.width - barWidth) * t, bounds.y + bounds.height - barHeight, barWidth, barHeight }, rui_apply_alpha(bs->text));
+
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    Vector2 textSize = MeasureTextEx(fs->font, text, (float)fs->size, fs->spacing);
+    Color textColor = bs->text;
+    textColor.a /= 2; // dimmed while busy
+    rui_draw_text(fs->font, text, (Vector2){ bounds.x + (bounds.width - textSize.x) * 0.5f, bounds.y + (bounds.height - textSize.y) * 0.5f },
+                  (float)fs->size, fs->spacing, rui_apply_alpha(textColor));
+    rui_damage_track(bounds, rui_hash_int(phase, rui_hash_string(text, 0x6a6f62))); // the bar moves every frame
+}
+
+bool rui_button_call_async(const char *text, Rectangle bounds, rui_job *job, void (*callback)(void *), void *userData) {
+    if (rui_job_busy(job)) {
+        rui_button_busy(text, bounds);
+        return false;
+    }
+    bool pressed = rui_button(text, bounds);
+    if (pressed && callback) rui_job_start(job, callback, userData);
+    return pressed;
+}
+
+void rui_panel_job_init(rui_panel_job *job, void (*build)(void *userData), void *userData, int z) { // fresh layout and empty command list
+    if (!job) return;
+    *job = (rui_panel_job){0};
+    job->build = build;
+    job->userData = userData;
+    job->z = z;
+    rui_layout_init(&job->layout);
+}
+
+static void rui_panel_job_build(void *arg) { // runs on a worker (or inline): build into the job's own layout and list
+    rui_panel_job *job = (rui_panel_job *)arg;
+    rui_context *previousContext = rui_ctx;
+    rui_layout_state *previousLayout = rui_layout;
+    rui_ctx = job->context; // theme, input and focus of the context that ran the jobs
+    rui_layout = &job->layout; // thread-local, so concurrent jobs never share layout state
+    rui_draw_list_reset(&job->commands);
+    job->layout.drawRecordTarget = &job->commands;
+    job->layout.drawExecute = false; // workers have no GL context
+    job->layout.hoverHashPrev = job->layout.hoverHash;
+    job->layout.hoverHash = 0;
+    job->layout.activity = false;
+    if (job->build) job->build(job->userData);
+    job->layout.drawRecordTarget = NULL;
+    rui_ctx = previousContext;
+    rui_layout = previousLayout;
+}
+
+void rui_panel_jobs_run(rui_panel_job *jobs, int count) { // build every job, then merge them into this frame in z order
+    if (!jobs || count <= 0) return;
+    if (!rui_ctx->skin) rui_theme_reset(); // workers only read the theme
+
+    rui_layout_state *mainLayout = rui_layout;
+    int pending = 0;
+    for (int i = 0; i < count; ++i) jobs[i].context = rui_ctx;
+    for (int i = 1; i < count; ++i) rui_task_submit(rui_panel_job_build, &jobs[i], &pending);
+    rui_panel_job_build(&jobs[0]); // the calling thread takes the first job itself
+    rui_task_wait(&pending);
+
+    int last = -1; // merge in (z, index) order; job counts are small, so no sort buffer is kept
+    for (int n = 0; n < count; ++n) {
+        int next = -1;
+        for (int i = 0; i < count; ++i) {
+            bool afterLast = last < 0 || jobs[i].z > jobs[last].z || (jobs[i].z == jobs[last].z && i > last);
+            if (afterLast && (next < 0 || jobs[i].z < jobs[next].z)) next = i;
+        }
+        last = next;
+        rui_panel_job *job = &jobs[next];
+        if (rui_draw_executing()) rui_draw_list_submit(&job->commands);
+        if (rui_draw_recording()) rui_draw_list_append(mainLayout->drawRecordTarget, &job->commands);
+        if (job->layout.activity || job->layout.sliderDragging || rui_layout_scrolling(&job->layout)) mainLayout->activity = true;
+        mainLayout->hoverHash = rui_hash_int((int)job->layout.hoverHash, mainLayout->hoverHash);
+        if (rui_damageEnabled) {
+            Rectangle bounds;
+            unsigned int hash = rui_draw_list_hash(&job->commands, &bounds);
+            rui_damage_track(bounds, hash); // whole job as one record
+        }
+    }
+}
+
+void rui_panel_job_free(rui_panel_job *job) { // release the recorded commands
+    if (!job) return;
+    rui_draw_list_free(&job->commands);
+}
+
+// --- Undo Log ---
+// An entry says "at target + offset, these old bytes became these new bytes". Values (floats, ints,
+// bools) overwrite in place; text entries splice a null-terminated buffer, so an edit costs the changed
+// characters rather than a copy of the string. Entries are variable-sized and stored back to back in
+// a byte ring addressed by ever-growing logical offsets; the size is written at both ends so undo can
+// walk backwards and the oldest entries can be dropped from the front.
+
+typedef struct rui_undo_entry { // header of an entry in the ring
+    int size; // whole entry: header, both byte runs and the trailing size
+    int text; // splice a null-terminated buffer instead of overwriting
+    void *target; // edited memory (value or text buffer)
+    rui_text_input *input; // text entries: box whose length/caret follow undo (may be NULL)
+    int capacity; // text entries: buffer size when recorded, so a splice can never outgrow it
+    int offset; // first changed byte
+    int removed; // old bytes
+    int inserted; // new bytes
+} rui_undo_entry;
+
+static rui_undo_log *rui_undoLog = NULL; // log widgets record into (UI thread only)
+static void *rui_undoNext = NULL; // target for the next slider or toggle
+
+static void rui_undo_put(rui_undo_log *log, long long at, const void *src, int count) { // copy into the ring, wrapping once
+    int physical = (int)(at % log->budget);
+    int first = count < log->budget - physical ? count : log->budget - physical;
+    memcpy(log->ring + physical, src, (size_t)first);
+    if (count > first) memcpy(log->ring, (const unsigned char *)src + first, (size_t)(count - first));
+}
+
+static void rui_undo_get(const rui_undo_log *log, long long at, void *dst, int count) {
+    int physical = (int)(at % log->budget);
+    int first = count < log->budget - physical ? count : log->budget - physical;
+    memcpy(dst, log->ring + physical, (size_t)first);
+    if (count > first) memcpy((unsigned char *)dst + first, log->ring, (size_t)(count - first));
+}
+
+static unsigned char *rui_undo_scratch(rui_undo_log *log, int size) {
+    void *grown = rui_grow(log->scratch, &log->scratchCapacity, size, 1);
+    if (grown) log->scratch = (unsigned char *)grown;
+    return grown ? log->scratch : NULL;
+}
+
+bool rui_undo_init(rui_undo_log *log, int budgetBytes) {
+    if (!log) return false;
+    *log = (rui_undo_log){ 0 };
+    if (budgetBytes < 256) budgetBytes = 256; // room for a handful of entries at least
+    log->ring = (unsigned char *)rui_realloc(NULL, (size_t)budgetBytes);
+    if (!log->ring) return false;
+    log->budget = budgetBytes;
+    return true;
+}
+
+void rui_undo_free(rui_undo_log *log) {
+    if (!log) return;
+    if (rui_undoLog == log) rui_undoLog = NULL;
+    rui_free(log->ring);
+    rui_free(log->scratch);
+    rui_free(log->before);
+    *log = (rui_undo_log){ 0 };
+}
+
+void rui_undo_record(rui_undo_log *log) {
+    if (!rui_shared_owner()) return; // widgets of other contexts never record
+    rui_undoLog = log && log->ring ? log : NULL;
+}
+
+void rui_undo_next(void *value) {
+    if (!rui_shared_owner()) return; // panel jobs and other contexts never record
+    rui_undoNext = value;
+}
+
+void rui_undo_break(rui_undo_log *log) {
+    if (log) log->open = NULL;
+}
+
+void rui_undo_clear(rui_undo_log *log) {
+    if (!log) return;
+    log->start = log->cursor = log->end = 0;
+    log->open = NULL;
+    log->revision++;
+}
+
+bool rui_undo_available(const rui_undo_log *log) {
+    return log && log->cursor > log->start;
+}
+
+bool rui_redo_available(const rui_undo_log *log) {
+    return log && log->end > log->cursor;
+}
+
+static void rui_undo_push(rui_undo_log *log, rui_undo_entry head, const void *removed, const void *inserted) { // append, dropping redo and the oldest entries
+    head.size = (int)sizeof(head) + head.removed + head.inserted + (int)sizeof(int);
+    log->end = log->cursor;
+    log->revision++;
+    if (head.size > log->budget) { // can never fit; older entries would undo against the wrong text, so drop them too
+        rui_undo_clear(log);
+        return;
+    }
+    while (log->end - log->start + head.size > log->budget) {
+        int oldest;
+        rui_undo_get(log, log->start, &oldest, (int)sizeof(oldest));
+        log->start += oldest;
+    }
+    long long at = log->end;
+    rui_undo_put(log, at, &head, (int)sizeof(head));
+    at += (long long)sizeof(head);
+    rui_undo_put(log, at, removed, head.removed);
+    at += head.removed;
+    rui_undo_put(log, at, inserted, head.inserted);
+    at += head.inserted;
+    rui_undo_put(log, at, &head.size, (int)sizeof(head.size));
+    log->cursor = log->end = at + (long long)sizeof(head.size);
+}
+
+static bool rui_undo_last(const rui_undo_log *log, const void *target, rui_undo_entry *head, long long *at) { // newest entry, if it is still open for target
+    if (log->open != target || log->cursor != log->end || log->cursor <= log->start) return false;
+    int size;
+    rui_undo_get(log, log->cursor - (long long)sizeof(size), &size, (int)sizeof(size));
+    *at = log->cursor - size;
+    rui_undo_get(log, *at, head, (int)sizeof(*head));
+    return head->target == target;
+}
+
+static void rui_undo_value(void *target, const void *before, const void *after, int size, bool held) { // a value widget ran: record (or extend) its edit
+    rui_undo_log *log = rui_undoLog;
+    if (!log || !target || !rui_shared_owner()) return;
+    bool changed = memcmp(before, after, (size_t)size) != 0;
+    if (changed) {
+        rui_undo_entry head;
+        long long at;
+        if (rui_undo_last(log, target, &head, &at) && !head.text && head.removed == size) { // same drag: only the new value moves
+            long long newAt = at + (long long)sizeof(head) + size;
+            rui_undo_put(log, newAt, after, size);
+            unsigned char *old = rui_undo_scratch(log, size);
+            if (old) rui_undo_get(log, at + (long long)sizeof(head), old, size);
+            log->revision++;
+            if (old && memcmp(old, after, (size_t)size) == 0) { // dragged back to where it started: the entry goes, and so does the run
+                log->cursor = log->end = at;
+                log->open = NULL;
+                return; // moving on starts a new entry rather than merging into the one before
+            }
+        } else {
+            head = (rui_undo_entry){ .target = target, .removed = size, .inserted = size };
+            rui_undo_push(log, head, before, after);
+        }
+    }
+    if (held && changed) log->open = target; // only an entry this gesture wrote may be extended
+    else if (!held && log->open == target) log->open = NULL; // gesture over
+}
+
+static void rui_undo_text_begin(rui_text_input *input) { // before a text box applies keys or a completion
+    rui_undo_log *log = rui_undoLog;
+    if (!log || !rui_shared_owner()) return;
+    if (rui_ctx->activeTextInput != input) { // unfocused: its typing run is over
+        if (log->open == input->buffer) log->open = NULL;
+        return;
+    }
+    void *grown = rui_grow(log->before, &log->beforeCapacity, input->length + 1, 1);
+    if (!grown) return;
+    log->before = (char *)grown;
+    memcpy(log->before, input->buffer, (size_t)input->length + 1);
+    log->beforeOf = input;
+}
+
+static void rui_undo_text_end(rui_text_input *input) { // record the difference as one splice, merged into the open run when adjacent
+    rui_undo_log *log = rui_undoLog;
+    if (!log || log->beforeOf != input) return;
+    log->beforeOf = NULL;
+    const char *before = log->before;
+    const char *after = input->buffer;
+    int beforeLength = (int)strlen(before), afterLength = input->length;
+    int prefix = 0;
+    while (prefix < beforeLength && prefix < afterLength && before[prefix] == after[prefix]) prefix++;
+    int suffix = 0;
+    while (suffix < beforeLength - prefix && suffix < afterLength - prefix && before[beforeLength - 1 - suffix] == after[afterLength - 1 - suffix]) suffix++;
+    int removed = beforeLength - prefix - suffix, inserted = afterLength - prefix - suffix;
+    bool focused = rui_ctx->activeTextInput == input;
+    if (removed == 0 && inserted == 0) {
+        if (!focused && log->open == input->buffer) log->open = NULL;
+        return;
+    }
+
+    rui_undo_entry head;
+    long long at;
+    if (rui_undo_last(log, input->buffer, &head, &at) && head.text) { // extend the typing run when the edit touches its end
+        int o = head.offset, r = head.removed, n = head.inserted;
+        int merged = -1; // new offset, or -1 when the edit is not adjacent
+        int mergedRemoved = 0, mergedInserted = 0;
+        if (removed == 0 && prefix == o + n) { merged = o; mergedRemoved = r; mergedInserted = n + inserted; } // typing on
+        else if (inserted == 0 && prefix + removed == o + n && removed <= n) { merged = o; mergedRemoved = r; mergedInserted = n - removed; } // backspacing what was typed
+        else if (inserted == 0 && n == 0 && prefix + removed == o) { merged = prefix; mergedRemoved = removed + r; mergedInserted = 0; } // backspacing further
+        else if (inserted == 0 && n == 0 && prefix == o) { merged = o; mergedRemoved = r + removed; mergedInserted = 0; } // deleting forwards
+        unsigned char *work = merged >= 0 ? rui_undo_scratch(log, head.size + mergedRemoved + mergedInserted) : NULL;
+        if (work) {
+            rui_undo_get(log, at, work, head.size);
+            unsigned char *oldBytes = work + head.size, *newBytes = oldBytes + mergedRemoved;
+            const unsigned char *entryOld = work + sizeof(head), *entryNew = entryOld + r;
+            if (merged == prefix && merged != o) { // removed text lies in front of the run's old text
+                memcpy(oldBytes, before + prefix, (size_t)removed);
+                memcpy(oldBytes + removed, entryOld, (size_t)r);
+            } else {
+                memcpy(oldBytes, entryOld, (size_t)r);
+                if (mergedRemoved > r) memcpy(oldBytes + r, before + prefix, (size_t)removed);
+            }
+            memcpy(newBytes, entryNew, (size_t)(mergedInserted < n ? mergedInserted : n));
+            if (mergedInserted > n) memcpy(newBytes + n, after + prefix, (size_t)inserted);
+            log->cursor = log->end = at; // replace the entry
+            if (mergedRemoved > 0 || mergedInserted > 0) {
+                head.offset = merged;
+                head.removed = mergedRemoved;
+                head.inserted = mergedInserted;
+                rui_undo_push(log, head, oldBytes, newBytes);
+                log->open = focused ? input->buffer : NULL;
+            } else {
+                log->revision++; // typed and erased again: nothing left to undo
+                log->open = NULL; // the next keystroke must not merge into the entry before
+            }
+            return;
+        }
+    }
+    head = (rui_undo_entry){ .text = 1, .target = input->buffer, .input = input, .capacity = input->capacity, .offset = prefix, .removed = removed, .inserted = inserted };
+    rui_undo_push(log, head, before + prefix, after + prefix);
+    log->open = focused ? input->buffer : NULL;
+}
+
+static bool rui_undo_apply(rui_undo_log *log, long long at, bool forward) { // write one entry's old (or new) bytes back
+    int size;
+    rui_undo_get(log, at, &size, (int)sizeof(size));
+    unsigned char *entry = rui_undo_scratch(log, size);
+    if (!entry) return false;
+    rui_undo_get(log, at, entry, size);
+    rui_undo_entry head;
+    memcpy(&head, entry, sizeof(head));
+    const unsigned char *from = entry + sizeof(head) + (forward ? 0 : head.removed); // bytes in the target now
+    const unsigned char *to = entry + sizeof(head) + (forward ? head.removed : 0); // bytes to put back
+    int fromCount = forward ? head.removed : head.inserted, toCount = forward ? head.inserted : head.removed;
+    unsigned char *target = (unsigned char *)head.target;
+    if (!head.text) {
+        memcpy(target + head.offset, to, (size_t)toCount);
+    } else {
+        char *buffer = (char *)target;
+        int length = (int)strlen(buffer);
+        if (head.offset + fromCount > length || memcmp(buffer + head.offset, from, (size_t)fromCount) != 0) return false; // edited behind the log's back
+        if (length - fromCount + toCount + 1 > head.capacity) return false; // text appended outside the log: the splice would overrun the buffer
+        memmove(buffer + head.offset + toCount, buffer + head.offset + fromCount, (size_t)(length - head.offset - fromCount) + 1);
+        memcpy(buffer + head.offset, to, (size_t)toCount);
+        if (head.input && head.input->buffer == buffer) { // keep the box's cached length and caret in step
+            head.input->length = length - fromCount + toCount;
+            head.input->cursor = head.offset + toCount;
+        }
+    }
+    log->open = NULL;
+    log->revision++;
+    if (rui_layout) rui_layout->activity = true;
+    return true;
+}
+
+void rui_undo_forget(rui_undo_log *log, const void *memory, size_t size) { // compact the ring in place, keeping order
+    if (!log || !log->ring || !memory || size == 0) return;
+    const unsigned char *lo = (const unsigned char *)memory, *hi = lo + size;
+    long long read = log->start, write = log->start, cursor = log->start;
+    bool dropped = false;
+    while (read < log->end) {
+        int entrySize;
+        rui_undo_get(log, read, &entrySize, (int)sizeof(entrySize));
+        unsigned char *entry = rui_undo_scratch(log, entrySize);
+        if (!entry) { // can't move entries without scratch: forgetting everything is the safe answer
+            rui_undo_clear(log);
+            return;
+        }
+        rui_undo_get(log, read, entry, entrySize);
+        rui_undo_entry head;
+        memcpy(&head, entry, sizeof(head));
+        const unsigned char *first = (const unsigned char *)head.target + (head.text ? 0 : head.offset);
+        const unsigned char *last = head.text ? (const unsigned char *)head.target + head.capacity : first + head.removed;
+        const unsigned char *input = (const unsigned char *)head.input;
+        if ((first < hi && last > lo) || (input >= lo && input < hi)) { // edits the forgotten memory, or its box lives there
+            dropped = true;
+        } else {
+            if (write != read) rui_undo_put(log, write, entry, entrySize); // write never passes read, so later entries are intact
+            write += entrySize;
+        }
+        read += entrySize;
+        if (read <= log->cursor) cursor = write; // applied entries stay applied
+    }
+    if ((const unsigned char *)log->open >= lo && (const unsigned char *)log->open < hi) log->open = NULL;
+    if (!dropped) return;
+    log->end = write;
+    log->cursor = cursor;
+    log->revision++;
+}
+
+bool rui_undo(rui_undo_log *log) {
+    if (!rui_undo_available(log)) return false;
+    int size;
+    rui_undo_get(log, log->cursor - (long long)sizeof(size), &size, (int)sizeof(size));
+    if (!rui_undo_apply(log, log->cursor - size, false)) {
+        rui_undo_clear(log); // the target no longer matches: the rest of the history can't apply either
+        return false;
+    }
+    log->cursor -= size;
+    return true;
+}
+
+bool rui_redo(rui_undo_log *log) {
+    if (!rui_redo_available(log)) return false;
+    int size;
+    rui_undo_get(log, log->cursor, &size, (int)sizeof(size));
+    if (!rui_undo_apply(log, log->cursor, true)) {
+        log->end = log->cursor; // drop the redo branch that no longer applies
+        return false;
+    }
+    log->cursor += size;
+    return true;
+}
+
+// --- Basic Widgets ---
+
+void rui_label(const char *text, Vector2 pos) { // draw plain text label with default color
+    rui_label_color(text, pos, rui_ctx->skin->theme.panel.labelColor); // delegate to colored label helper with theme tone
+}
+
+void rui_label_color(const char *text, Vector2 pos, Color color) { // draw text label with supplied color
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    rui_draw_text(fs->font, text, (Vector2){ pos.x, pos.y }, (float)fs->size, fs->spacing, rui_apply_alpha(color)); // render text with themed font
+    if (rui_damageEnabled) { // labels only need measuring when damage is tracked
+        Vector2 size = MeasureTextEx(fs->font, text, (float)fs->size, fs->spacing);
+        rui_damage_track((Rectangle){ pos.x, pos.y, size.x, size.y }, rui_hash_bytes(&color, (int)sizeof(color), rui_hash_string(text, 0)));
+    }
+}
+
+bool rui_button(const char *text, Rectangle bounds) { // draw interactive button
+    const rui_button_style *bs = &rui_ctx->skin->theme.button; // fetch theme colours
+    bool hovered = rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, bounds)); // check if mouse over button
+    bool pressed = hovered && rui_ctx->mousePressed; // register press only when hovered
+
+    Color bg = hovered ? bs->hover : bs->normal; // choose hover background color
+    if (pressed) bg = bs->pressed; // darken when actively pressed
+
+    int fill = rui_draw_rect(bounds, rui_apply_alpha(bg)); // fill button background
+    rui_draw_patch_add(fill, bounds, rui_apply_alpha(bs->normal), rui_apply_alpha(bs->hover), NULL); // hover follows the cursor on replayed frames
+    rui_draw_rect_lines(bounds, rui_ctx->skin->metrics.border, rui_apply_alpha(bs->border)); // outline button for contrast
+
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    Vector2 textSize = MeasureTextEx(fs->font, text, (float)fs->size, fs->spacing);
+    float textX = bounds.x + (bounds.width - textSize.x) * 0.5f;
+    float textY = bounds.y + (bounds.height - textSize.y) * 0.5f;
+    rui_draw_text(fs->font, text, (Vector2){ textX, textY }, (float)fs->size, fs->spacing, rui_apply_alpha(bs->text)); // draw button label
+    rui_damage_track(bounds, rui_hash_int(hovered | (pressed << 1), rui_hash_string(text, 0))); // hover/press changes repaint the button
+
+    return pressed; // return true when clicked
+}
+
+bool rui_button_call(const char *text, Rectangle bounds, void (*callback)(void *), void *userData) { // draw button and fire callback
+    bool pressed = rui_button(text, bounds); // reuse core button drawing logic
+    if (pressed && callback) { // invoke user callback only when pressed and provided
+        callback(userData); // call user-supplied function with context pointer
+    }
+    return pressed; // propagate pressed state to caller
+}
+
+static bool rui_draw_close_button(Rectangle bounds, const char *label, Color borderColor) { // render close button in panel chrome
+    bool hovered = rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, bounds)); // hover detection
+    bool pressed = hovered && rui_ctx->mousePressed; // click detection
+
+    Color base = hovered ? (Color){210, 80, 80, 255} : (Color){190, 60, 60, 255}; // background tint
+    if (pressed) base = (Color){150, 40, 40, 255}; // darker when pressed
+
+    int fill = rui_draw_rect(bounds, rui_apply_alpha(base)); // fill button
+    rui_draw_patch_add(fill, bounds, rui_apply_alpha((Color){190, 60, 60, 255}), rui_apply_alpha((Color){210, 80, 80, 255}), NULL);
+    rui_draw_rect_lines(bounds, rui_ctx->skin->metrics.border, rui_apply_alpha(borderColor)); // outline to match panel
+
+    const char *text = label ? label : "X"; // default label
+    const rui_font_style *tf = &rui_ctx->skin->metrics.titleFont;
+    float baseSize = (float)tf->size;
+    if (baseSize <= 0.0f) baseSize = rui_ctx->skin->metrics.closeButton;
+    float drawSize = baseSize;
+    if (drawSize > bounds.height - 2.0f * rui_ctx->skin->metrics.border) drawSize = bounds.height - 2.0f * rui_ctx->skin->metrics.border; // fit inside button
+    if (drawSize < 8.0f) drawSize = 8.0f;
+    float spacing = tf->spacing;
+    if (baseSize != drawSize) {
+        float scale = drawSize / baseSize;
+        spacing *= scale;
+    }
+    Vector2 textSize = MeasureTextEx(tf->font, text, drawSize, spacing);
+    Vector2 textPos = {
+        bounds.x + (bounds.width - textSize.x) * 0.5f,
+        bounds.y + (bounds.height - textSize.y) * 0.5f
+    };
+    rui_draw_text(tf->font, text, textPos, drawSize, spacing, rui_apply_alpha(WHITE)); // draw label centered
+    rui_damage_track(bounds, rui_hash_int(hovered | (pressed << 1), rui_hash_string(text, 0)));
+
+    return pressed; // signal click
+}
+
+float rui_slider(Rectangle bounds, float value, float minValue, float maxValue) { // draw horizontal slider and return new value
+    if (maxValue < minValue) { // guard against inverted range
+        float tmp = minValue;
+        minValue = maxValue;
+        maxValue = tmp;
+    }
+
+    const rui_metrics *m = &rui_ctx->skin->metrics;
+    if ( bounds.width < m->knobSize ) bounds.width = m->knobSize; // ensure room for knob
+    float trackHeight = m->trackHeight; // thickness of slider track
+    float trackY = bounds.y + (bounds.height - trackHeight) * 0.5f; // center track vertically
+    Rectangle track = { bounds.x, trackY, bounds.width, trackHeight }; // track rectangle
+    rui_draw_rect(track, rui_apply_alpha(rui_ctx->skin->theme.slider.track)); // draw track background
+
+    float knobWidth = m->knobSize; // knob width
+    float travel = bounds.width - knobWidth; // horizontal travel distance for knob
+    float clampedValue = Clamp(value, minValue, maxValue); // ensure value within range
+    float t = (maxValue - minValue) > 0 ? (clampedValue - minValue) / (maxValue - minValue) : 0.0f; // normalize value 0-1
+    float knobX = bounds.x + t * travel; // compute knob position
+    Rectangle knob = { knobX, bounds.y + (bounds.height - knobWidth) * 0.5f, knobWidth, knobWidth }; // knob bounds
+
+    bool hovered = rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, knob) || CheckCollisionPointRec(rui_ctx->mouse, track)); // hover on knob or track
+    bool dragging = rui_layout->sliderDragging; // dragging state lives in the layout (single slider usage per frame)
+    Rectangle activeSlider = rui_layout->activeSlider; // remember which slider is active
+
+    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
+        if (!dragging && hovered) { // start drag when first clicking on slider
+            dragging = true;
+            activeSlider = bounds;
+        }
+    } else {
+        dragging = false; // release drag when button up
+    }
+    rui_layout->sliderDragging = dragging;
+    rui_layout->activeSlider = activeSlider;
+    rui_layout->sliderHeld = false;
+
+    if (dragging && activeSlider.x == bounds.x && activeSlider.y == bounds.y && activeSlider.width == bounds.width) {
+        float mouseT = (rui_ctx->mouse.x - bounds.x - knobWidth * 0.5f) / travel; // compute based on mouse x
+        if (travel <= 0) mouseT = 0;
+        if (mouseT < 0) mouseT = 0;
+        if (mouseT > 1) mouseT = 1;
+        clampedValue = minValue + mouseT * (maxValue - minValue); // update value based on mouse position
+        t = mouseT; // update normalized value for knob drawing
+        knob.x = bounds.x + t * travel; // update knob position
+        rui_layout->panelCacheDirty = true; // keep a cached panel live while its slider is dragged
+        rui_layout->sliderHeld = true;
+    }
+
+    Color knobColor = dragging ? rui_ctx->skin->theme.slider.knobDrag
+                      : (hovered ? rui_ctx->skin->theme.slider.knobHover : rui_ctx->skin->theme.slider.knob); // knob tint
+    int knobFill = rui_draw_rect(knob, rui_apply_alpha(knobColor)); // draw knob
+    rui_draw_rect_lines(knob, rui_ctx->skin->metrics.border, rui_apply_alpha(rui_ctx->skin->theme.button.border)); // outline knob using button border colour
+
+    Rectangle covered = bounds; // knob may stick out of short slider bounds
+    if (knob.y < covered.y) { covered.height += covered.y - knob.y; covered.y = knob.y; }
+    if (knob.y + knob.height > covered.y + covered.height) covered.height = knob.y + knob.height - covered.y;
+    if (!dragging) { // a held knob forces rebuilds anyway
+        Rectangle hot = { track.x, knob.y, track.width, knob.height }; // knob or track, as hover test above
+        rui_draw_patch_add(knobFill, hot, rui_apply_alpha(rui_ctx->skin->theme.slider.knob), rui_apply_alpha(rui_ctx->skin->theme.slider.knobHover), NULL);
+    }
+    rui_damage_track(covered, rui_hash_bytes(&knobColor, (int)sizeof(knobColor), rui_hash_float(knob.x, 0)));
+    if (rui_shared_owner() && rui_undoNext) { // only drags are edits; clamping an out-of-range value is not
+        float before = rui_layout->sliderHeld ? value : clampedValue;
+        rui_undo_value(rui_undoNext, &before, &clampedValue, (int)sizeof(float), rui_layout->sliderHeld);
+        rui_undoNext = NULL;
+    }
+
+    return clampedValue; // return potentially updated value
+}
+
+bool rui_toggle(Rectangle bounds, bool value, const char *label) { // draw checkbox and label
+    float boxSize = bounds.height; // square checkbox fitting height
+    if (boxSize > bounds.width) boxSize = bounds.width; // ensure fits inside bounds
+    Rectangle box = { bounds.x, bounds.y, boxSize, boxSize }; // checkbox rectangle
+    float gap = rui_ctx->skin->metrics.toggleGap;
+    Rectangle textBounds = { bounds.x + boxSize + gap, bounds.y, bounds.width - boxSize - gap, bounds.height }; // text area
+
+    bool hovered = rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, bounds)); // hover when cursor over total bounds
+    bool toggled = hovered && rui_ctx->mousePressed; // flip state only on press while hovered
+    if (toggled) value = !value; // toggle value on click
+
+    Color border = hovered ? rui_ctx->skin->theme.toggle.borderHover : rui_ctx->skin->theme.toggle.border; // border tint when hovered
+    int outline = rui_draw_rect_lines(box, rui_ctx->skin->metrics.border, rui_apply_alpha(border)); // outline checkbox
+    rui_draw_patch_add(outline, bounds, rui_apply_alpha(rui_ctx->skin->theme.toggle.border), rui_apply_alpha(rui_ctx->skin->theme.toggle.borderHover), NULL);
+    Color fillColor = value ? rui_ctx->skin->theme.toggle.fillActive : rui_ctx->skin->theme.toggle.fill; // fill based on state
+    float inset = rui_ctx->skin->metrics.toggleInset;
+    rui_draw_rect((Rectangle){ box.x + inset, box.y + inset, box.width - inset * 2.0f, box.height - inset * 2.0f }, rui_apply_alpha(fillColor));
+
+    if (label) { // draw optional label text
+        const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+        Vector2 textSize = MeasureTextEx(fs->font, label, (float)fs->size, fs->spacing);
+        Vector2 pos = {
+            textBounds.x,
+            bounds.y + (bounds.height - textSize.y) * 0.5f
+        };
+        rui_draw_text(fs->font, label, pos, (float)fs->size, fs->spacing, rui_apply_alpha(rui_ctx->skin->theme.toggle.label));
+    }
+    rui_damage_track(bounds, rui_hash_int(hovered | (value << 1), rui_hash_string(label, 0)));
+    if (rui_shared_owner() && rui_undoNext) {
+        bool before = toggled ? !value : value;
+        rui_undo_value(rui_undoNext, &before, &value, (int)sizeof(bool), false);
+        rui_undoNext = NULL;
+    }
+
+    return value; // return possibly toggled value
+}
+
+float rui_slider_call(Rectangle bounds, float value, float minValue, float maxValue, void (*callback)(float, void *), void *userData) { // slider with callback
+    float newValue = rui_slider(bounds, value, minValue, maxValue); // draw slider and get new value
+    rui_change_float(callback, userData, rui_change_widget(bounds), newValue, newValue != value, rui_layout->sliderHeld); // now or queued, per policy
+    return newValue; // return current slider value
+}
+
+bool rui_toggle_call(Rectangle bounds, bool value, const char *label, void (*callback)(bool, void *), void *userData) { // toggle with callback
+    bool newValue = rui_toggle(bounds, value, label); // draw toggle and get new state
+    rui_change_bool(callback, userData, rui_change_widget(bounds), newValue, newValue != value); // now or queued, per policy
+    return newValue; // return current toggle state
+}
+
+rui_text_input rui_text_input_init(char *buffer, int capacity) { // convenience initializer for text input state
+    rui_text_input input = {0}; // zero initialize struct
+    input.buffer = buffer; // assign caller buffer
+    input.capacity = capacity; // set capacity
+    if (buffer && capacity > 0) { // ensure buffer valid
+        input.length = (int)TextLength(buffer); // pre-populate length from existing text
+        if (input.length >= capacity) { // clamp length to capacity - 1
+            input.length = capacity - 1;
+            buffer[input.length] = '\0';
+        }
+        input.cursor = input.length; // place cursor at end of text
+    }
+    input.active = false; // start unfocused
+    input.blinkTimer = 0.0f; // reset blink timer
+    return input; // return initialized struct
+}
+
+static void rui_text_input_set_cursor(rui_text_input *input, int position) { // helper to clamp cursor position
+    if (!input) return;
+    if (position < 0) position = 0;
+    if (position > input->length) position = input->length;
+    input->cursor = position;
+}
+
+static void rui_text_input_insert_char(rui_text_input *input, int character) { // insert Unicode codepoint into buffer
+    if (!input || !input->buffer) return;
+    if (character == 0 || character == 127) return; // ignore null and delete key
+    if (character < 32) return; // skip non-printable control characters
+    if (input->length + 1 >= input->capacity) return; // avoid overflow
+
+    for (int i = input->length; i >= input->cursor; --i) { // shift characters to make space
+        input->buffer[i + 1] = input->buffer[i];
+    }
+
+    input->buffer[input->cursor] = (char)character; // insert character at cursor
+    input->length++;
+    rui_text_input_set_cursor(input, input->cursor + 1); // advance cursor
+}
+
+static void rui_text_input_backspace(rui_text_input *input) { // handle backspace deletion
+    if (!input || input->cursor <= 0) return;
+    for (int i = input->cursor - 1; i <= input->length; ++i) { // shift characters left
+        input->buffer[i] = input->buffer[i + 1];
+    }
+    input->length--;
+    rui_text_input_set_cursor(input, input->cursor - 1); // move cursor back
+}
+
+static void rui_text_input_delete(rui_text_input *input) { // handle delete key
+    if (!input || input->cursor >= input->length) return;
+    for (int i = input->cursor; i <= input->length; ++i) {
+        input->buffer[i] = input->buffer[i + 1];
+    }
+    input->length--;
+}
+
+static void rui_text_input_set_active(rui_text_input *input) { // centralize active input management
+    if (rui_ctx->activeTextInput && rui_ctx->activeTextInput != input) {
+        rui_ctx->activeTextInput->active = false; // deactivate previous input
+    }
+    rui_ctx->activeTextInput = input; // store new active input (may be NULL)
+    rui_ctx->keyboardCaptured = (input != NULL); // update capture flag
+    if (input) input->active = true; // mark new input as active
+}
+
+bool rui_text_input_box(Rectangle bounds, rui_text_input *input) { // draw text box and handle typing
+    if (!input || !input->buffer || input->capacity <= 1) return false;
+
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+
+    bool hovered = rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, bounds)); // detect mouse over box
+    bool mainThread = rui_layout == &rui_ctx->layout; // raylib's key queues are not thread-safe, panel jobs can't take focus
+    if (rui_ctx->mousePressed && hovered && mainThread) { // focus when clicked
+        rui_text_input_set_active(input);
+        float relativeX = rui_ctx->mouse.x - bounds.x - rui_ctx->skin->metrics.textInset; // rough cursor placement
+        int caret = input->length;
+        float accumulated = 0.0f;
+        for (int i = 0; i < input->length; ++i) {
+            Vector2 glyph = MeasureTextEx(fs->font, (const char[]){input->buffer[i], '\0'}, (float)fs->size, fs->spacing);
+            float charWidth = glyph.x;
+            if (accumulated + charWidth * 0.5f >= relativeX) { caret = i; break; }
+            accumulated += charWidth;
+        }
+        rui_text_input_set_cursor(input, caret);
+    } else if (rui_ctx->mousePressed && !hovered && mainThread) {
+        if (rui_ctx->activeTextInput == input) { // clicking elsewhere defocuses
+            input->active = false;
+            rui_text_input_set_active(NULL);
+        }
+    }
+
+    bool changed = false;
+    rui_undo_text_begin(input);
+    if (rui_ctx->activeTextInput == input && mainThread) { // handle keyboard input only when active
+        int key = GetKeyPressed();
+        while (key > 0) { // process key presses
+            rui_layout->activity = true; // caret moves and focus changes need a fresh frame
             if (key == KEY_BACKSPACE) {
                 int prevLen = input->length;
                 rui_text_input_backspace(input);
@@ -693,497 +3544,2841 @@ bool rui_text_input_box(Rectangle bounds, rui_text_input *input) { // draw text
                 input->active = false;
                 rui_text_input_set_active(NULL); // exit focus on escape/enter
             }
-            key = GetKeyPressed();
+            key = GetKeyPressed();
+        }
+
+        int ch = GetCharPressed();
+        while (ch > 0) { // process character input
+            int prevLen = input->length;
+            rui_text_input_insert_char(input, ch);
+            changed |= (prevLen != input->length);
+            ch = GetCharPressed();
+        }
+
+        input->blinkTimer += rui_ctx->frameDelta; // advance caret blink
+        if (input->blinkTimer > 1.0f) input->blinkTimer -= 1.0f; // wrap timer
+        rui_layout->panelCacheDirty = true; // focused inputs blink and type, so never freeze them in a cache
+    } else {
+        input->blinkTimer = 0.0f; // reset when not active
+    }
+
+    if (changed) rui_layout->activity = true; // app usually reacts to text edits
+    rui_undo_text_end(input);
+
+    const rui_text_input_style *tis = &rui_ctx->skin->theme.textInput; // theme colours
+    Color borderColor = (rui_ctx->activeTextInput == input) ? tis->borderActive
+                        : (hovered ? tis->borderHover : tis->border); // highlight when focused
+    rui_draw_rect(bounds, rui_apply_alpha(tis->background)); // draw background
+    int border = rui_draw_rect_lines(bounds, rui_ctx->skin->metrics.border, rui_apply_alpha(borderColor)); // draw border
+    if (rui_ctx->activeTextInput != input) rui_draw_patch_add(border, bounds, rui_apply_alpha(tis->border), rui_apply_alpha(tis->borderHover), NULL);
+
+    float textHeight = (float)fs->size;
+    Vector2 textPos = { bounds.x + rui_ctx->skin->metrics.textInset, bounds.y + (bounds.height - textHeight) * 0.5f }; // baseline for text
+    rui_draw_text(fs->font,
+               input->buffer ? input->buffer : "",
+               textPos,
+               (float)fs->size,
+               fs->spacing,
+               rui_apply_alpha(tis->text)); // draw text contents
+    rui_damage_track(bounds, rui_hash_bytes(&borderColor, (int)sizeof(borderColor), rui_hash_string(input->buffer, 0)));
+
+    Rectangle caretRect = { 0 }; // stays empty while unfocused so the record slot is stable
+    if (rui_ctx->activeTextInput == input) { // draw caret when active
+        float caretX = textPos.x;
+        if (input->cursor > 0) {
+            char temp = input->buffer[input->cursor];
+            input->buffer[input->cursor] = '\0';
+            caretX += MeasureTextEx(fs->font, input->buffer, (float)fs->size, fs->spacing).x;
+            input->buffer[input->cursor] = temp;
+        }
+
+        Rectangle caret = { (float)(int)caretX, (float)(int)textPos.y, rui_ctx->skin->metrics.caretWidth, (float)fs->size };
+        bool caretVisible = fmodf(input->blinkTimer, 1.0f) < 0.5f; // blink on for half the time
+        if (caretVisible || rui_draw_recording()) { // hidden carets are still recorded so replays can blink them
+            int caretCommand = rui_draw_rect(caret, caretVisible ? rui_apply_alpha(tis->caret) : BLANK);
+            rui_draw_patch_add(caretCommand, caret, BLANK, rui_apply_alpha(tis->caret), input);
+        }
+        if (caretVisible) caretRect = caret;
+    }
+    rui_damage_track(caretRect, 0); // caret tracked separately: blinking repaints only a few pixels
+
+    return changed; // report whether text changed this frame
+}
+
+static void rui_change_text(void (*callback)(const char *, void *), void *userData, rui_text_input *input, bool changed) {
+    rui_change_event event = { 0 };
+    event.onText = callback;
+    event.userData = userData;
+    event.input = input;
+    event.held = rui_ctx->activeTextInput == input; // editing until the box loses focus
+    if (!callback) { rui_change_post(event, false); return; }
+    if (!rui_change_post(event, changed) && changed) callback(input->buffer, userData);
+}
+
+bool rui_text_input_box_call(Rectangle bounds, rui_text_input *input, void (*callback)(const char *, void *), void *userData) { // text box with change callback
+    bool changed = rui_text_input_box(bounds, input);
+    if (input && input->buffer) rui_change_text(callback, userData, input, changed);
+    return changed;
+}
+
+bool rui_keyboard_captured(void) { // let callers know UI owns keyboard this frame
+    return rui_ctx->keyboardCaptured;
+}
+
+bool rui_keyboard_captured_ctx(const rui_context *ctx) { // focus of a specific context
+    return ctx ? ctx->keyboardCaptured : false;
+}
+
+static void rui_fade_start(unsigned char targetAlpha, float duration) { // internal helper to configure fade animation
+    rui_ctx->fadeStartAlpha = rui_ctx->fadeAlpha; // remember current alpha as starting point
+    rui_ctx->fadeTargetAlpha = (float)targetAlpha; // store goal alpha value
+    rui_ctx->fadeDuration = duration; // store duration in seconds
+    rui_ctx->fadeElapsed = 0.0f; // reset elapsed timer
+    if (duration <= 0.0f) { // if duration zero or negative, snap immediately
+        rui_ctx->fadeAlpha = rui_ctx->fadeTargetAlpha;
+        rui_ctx->fadeActive = false;
+    } else {
+        rui_ctx->fadeActive = true; // mark fade as active
+    }
+}
+
+void rui_fade_set_color(Color color) { // choose color for fade overlay
+    rui_ctx->fadeColor = color; // store desired overlay tint (alpha controlled separately)
+}
+
+void rui_fade_out(float duration) { // start fade to fully opaque overlay
+    rui_fade_start(255, duration); // animate alpha to 255
+}
+
+void rui_fade_in(float duration) { // start fade back to transparent
+    rui_fade_start(0, duration); // animate alpha to 0
+}
+
+bool rui_fade_active(void) { // expose whether fade animation running
+    return rui_ctx->fadeActive; // simply return state flag
+}
+
+void rui_draw_fade(void) { // draw fade overlay if alpha greater than zero
+    if (rui_ctx->fadeAlpha <= 0.0f) return; // nothing to draw when alpha 0
+    Color overlay = rui_ctx->fadeColor; // copy base color
+    overlay.a = (unsigned char)Clamp(rui_ctx->fadeAlpha, 0.0f, 255.0f); // apply animated alpha
+    rui_draw_list *recording = rui_layout->drawRecordTarget;
+    if (rui_tickRate > 0.0f) rui_layout->drawRecordTarget = NULL; // the fade animates every frame, so it never goes into the replayed list
+    rui_draw_rect((Rectangle){ 0.0f, 0.0f, (float)GetRenderWidth(), (float)GetRenderHeight() }, overlay); // cover entire render surface
+    rui_layout->drawRecordTarget = recording;
+}
+
+// --- Idle Detection ---
+bool rui_needs_redraw(void) { // report whether the next frame can differ from this one without new input
+    if (rui_ctx->fadeActive || rui_layout->activity) return true; // animation running or state changed by clicks/edits
+    if (rui_ctx == &rui_contextDefault) { // process-wide work is reported by the default context only
+        if (rui_tweenMoving > 0) return true; // app tweens (panel fades etc.)
+        if (rui_budgetCount > 0) return true; // budgeted jobs still producing partial results
+        if (rui_jobActive) return true; // async callbacks still running: busy buttons animate and completions need polling
+    }
+    if (rui_layout->sliderDragging) return true; // drags follow the cursor
+    if (rui_layout_scrolling(rui_layout)) return true; // a scrollbar drag, or a kinetic scroll still gliding
+    if (rui_layout->hoverHash != rui_layout->hoverHashPrev) return true; // app code may react to what is hovered now
+    if (rui_damageEnabled && rui_ctx == &rui_contextDefault && rui_damage_rect().width > 0.0f) return true; // something visibly changed
+    return false;
+}
+
+double rui_next_wakeup(void) { // time until rui wants another frame on its own
+    if (rui_needs_redraw()) return 0.0;
+    double wake = rui_ctx == &rui_contextDefault ? rui_change_wakeup() : -1.0; // throttled and debounced callbacks still to run
+    if (rui_ctx->activeTextInput) { // caret toggles every half second
+        float phase = fmodf(rui_ctx->activeTextInput->blinkTimer, 0.5f);
+        if (wake < 0.0 || (double)(0.5f - phase) < wake) wake = (double)(0.5f - phase);
+    }
+    return wake; // < 0 when fully static: sleep until input arrives
+}
+
+// --- Manual Panel ---
+void rui_panel(Rectangle bounds, const char *title) { // draw basic panel using default style
+    rui_panel_ex(bounds, title, rui_ctx->panelStyleDefault); // forward to full implementation with default style
+}
+
+void rui_panel_ex(Rectangle bounds, const char *title, rui_panel_style style) { // draw a static panel shell with style
+    if (!rui_ctx->skin) {
+        rui_theme_reset();
+    }
+
+    rui_draw_rect(bounds, rui_apply_alpha(style.bodyColor)); // paint panel background with styled color
+    rui_draw_rect_lines(bounds, rui_ctx->skin->metrics.border, rui_apply_alpha(style.borderColor)); // outline panel borders using styled color
+
+    if (title) { // draw optional title bar when provided
+        float headerHeight = rui_calculate_header_height(true);
+        Rectangle titleBar = { bounds.x, bounds.y, bounds.width, headerHeight };
+        rui_draw_rect(titleBar, rui_apply_alpha(style.titleColor));
+        rui_draw_rect_lines(titleBar, rui_ctx->skin->metrics.hairline, rui_apply_alpha(style.borderColor));
+
+        const rui_font_style *tf = &rui_ctx->skin->metrics.titleFont;
+        float paddingY = (headerHeight - (float)tf->size) * 0.5f;
+        if (paddingY < 0.0f) paddingY = 0.0f;
+        rui_draw_text(tf->font,
+                   title,
+                   (Vector2){ bounds.x + rui_ctx->skin->metrics.headerPadding, bounds.y + paddingY },
+                   (float)tf->size,
+                   tf->spacing,
+                   rui_apply_alpha(style.titleTextColor));
+    }
+    rui_damage_track(bounds, rui_hash_bytes(&style, (int)sizeof(style), rui_hash_string(title, 0)));
+}
+
+// --- Panel Cache ---
+void rui_panel_cache_next(unsigned int contentHash) { // request caching for the next panel begin
+    rui_layout->panelCacheRequested = true;
+    rui_layout->panelCacheHash = contentHash;
+}
+
+bool rui_panel_cache_hit(void) { // let callers skip building content for cached panels
+    return rui_layout->panelCacheHit;
+}
+
+void rui_panel_cache_clear(void) { // release all render textures held by the cache
+    for (int i = 0; i < RUI_PANEL_CACHE_MAX; ++i) {
+        if (rui_panelCache[i].target.id != 0) UnloadRenderTexture(rui_panelCache[i].target);
+        rui_panelCache[i] = (rui_panel_cache_entry){0};
+    }
+}
+
+static rui_panel_cache_entry *rui_panel_cache_find(unsigned int id) { // find entry by id or recycle the least recently used one
+    rui_panel_cache_entry *victim = &rui_panelCache[0];
+    for (int i = 0; i < RUI_PANEL_CACHE_MAX; ++i) {
+        rui_panel_cache_entry *entry = &rui_panelCache[i];
+        if (entry->target.id != 0 && entry->id == id) return entry;
+        if (victim->target.id == 0) continue; // an empty slot always wins
+        if (entry->target.id == 0 || entry->lastUsed < victim->lastUsed) victim = entry;
+    }
+    victim->id = id;
+    victim->valid = false;
+    return victim;
+}
+
+static void rui_panel_cache_prepare(Rectangle bounds, const char *title, rui_panel_style style) { // decide between blit, capture and live draw
+    if (rui_layout != &rui_contextDefault.layout) return; // the texture pool belongs to the default context; jobs and other contexts draw live
+    unsigned int id = rui_hash_string(title, 0); // position is left out, so a dragged panel keeps its entry
+    for (int i = 0; i < RUI_PANEL_CACHE_MAX; ++i) { // a panel with this title already ran this frame: take the next id
+        const rui_panel_cache_entry *other = &rui_panelCache[i];
+        if (other->target.id != 0 && other->id == id && other->lastUsed == rui_frameIndex) {
+            id = rui_hash_int(1, id);
+            i = -1;
+        }
+    }
+    unsigned int styleHash = rui_hash_bytes(&style, (int)sizeof(style), rui_ctx->skin->hash);
+    styleHash = rui_hash_string(rui_layout->panelCloseRequested ? (rui_layout->panelCloseLabel ? rui_layout->panelCloseLabel : "X") : NULL, styleHash);
+
+    rui_panel_cache_entry *entry = rui_panel_cache_find(id);
+    entry->lastUsed = rui_frameIndex;
+
+    bool scrolling = rui_layout->panelScrollable && (rui_layout->draggingScrollbar || rui_layout->scrollVelocity != 0.0f); // this panel's own scroll state
+    bool interacting = CheckCollisionPointRec(rui_ctx->mouse, bounds) || scrolling || rui_ctx->activeCombo; // hover/press feedback, gliding content and open combos must stay live
+    if (interacting || !rui_layout->drawExecute) { // recorded-only frames can't render into textures on this thread
+        entry->valid = false; // recapture once the cursor leaves
+        return;
+    }
+
+    if (entry->valid &&
+        entry->contentHash == rui_layout->panelCacheHash &&
+        entry->styleHash == styleHash &&
+        entry->bounds.width == bounds.width &&
+        entry->bounds.height == bounds.height) {
+        entry->bounds = bounds; // captured relative to the panel, so it blits anywhere
+        entry->alpha = rui_layout->alphaCurrent; // a fading panel keeps its texture and only the blit tint changes
+        rui_layout->panelCacheEntry = entry;
+        rui_layout->panelCacheHit = true;
+        rui_layout->contentHeight = entry->contentHeight; // keep scroll bookkeeping consistent without running widgets
+        return;
+    }
+
+    int width = (int)ceilf(bounds.width);
+    int height = (int)ceilf(bounds.height);
+    if (width <= 0 || height <= 0) return;
+    if (entry->target.id == 0 || entry->target.texture.width != width || entry->target.texture.height != height) {
+        if (entry->target.id != 0) UnloadRenderTexture(entry->target);
+        entry->target = LoadRenderTexture(width, height);
+        if (entry->target.id == 0) return; // no render target available: draw live
+    }
+
+    entry->contentHash = rui_layout->panelCacheHash;
+    entry->styleHash = styleHash;
+    entry->alpha = rui_layout->alphaCurrent;
+    entry->bounds = bounds;
+    entry->valid = false; // becomes valid once the capture finishes cleanly
+    rui_layout->panelCacheEntry = entry;
+    rui_layout->panelCacheCapturing = true;
+    rui_layout->panelCacheDirty = false;
+
+    BeginTextureMode(entry->target);
+    ClearBackground(BLANK);
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE); // alpha accumulates as a + d(1 - a) instead of a*a, so the texture holds premultiplied colour and coverage
+    rui_layout->drawOrigin = (Vector2){ bounds.x, bounds.y };
+    rui_layout->alphaStack[rui_layout->alphaTop] = 1.0f; // capture opaque; entry->alpha is applied when blitting
+    rui_layout->alphaCurrent = 1.0f;
+    BeginMode2D((Camera2D){ .offset = { -bounds.x, -bounds.y }, .target = { 0.0f, 0.0f }, .rotation = 0.0f, .zoom = 1.0f }); // keep widget coordinates in screen space
+}
+
+static void rui_panel_cache_blit(const rui_panel_cache_entry *entry) { // draw the cached panel as one textured quad
+    Rectangle source = { 0.0f, 0.0f, (float)entry->target.texture.width, -(float)entry->target.texture.height }; // render textures are stored flipped
+    unsigned char a = (unsigned char)(rui_clamp01(entry->alpha) * 255.0f + 0.5f);
+    rui_draw_texture(entry->target.texture, source, (Vector2){ entry->bounds.x, entry->bounds.y }, (Color){ a, a, a, a }); // colour blended onto a transparent target and alpha accumulated separately: premultiplied, so the fade scales every channel
+}
+
+static void rui_panel_cache_finish(void) { // close the capture (if any) and present the cached texture
+    rui_panel_cache_entry *entry = rui_layout->panelCacheEntry;
+    if (rui_layout->panelCacheCapturing) {
+        EndMode2D();
+        EndBlendMode();
+        EndTextureMode();
+        rui_layout->drawOrigin = (Vector2){ 0.0f, 0.0f };
+        rui_layout->alphaStack[rui_layout->alphaTop] = entry->alpha; // back to the panel's own alpha for the pop in rui_panel_end
+        rui_layout->alphaCurrent = entry->alpha;
+        entry->contentHeight = rui_layout->contentHeight;
+        entry->valid = !rui_layout->panelCacheDirty; // focused/dragged widgets force a fresh capture next frame
+        rui_layout->panelCacheCapturing = false;
+    }
+    rui_panel_cache_blit(entry);
+    rui_layout->panelCacheEntry = NULL;
+    rui_layout->panelCacheHit = false;
+    rui_damage_track(entry->bounds, rui_hash_float(entry->alpha, rui_hash_int((int)entry->styleHash, entry->contentHash))); // whole cached panel as one record
+}
+
+// --- Auto-layout + Scrollable Panels ---
+// Layout runs in content space (y = 0 at the top of the content area) in double precision; only the
+// difference to the scroll offset is narrowed to float, so rows millions of pixels down stay pixel-exact.
+static double rui_clamp_offset(double offset, double maxOffset) { // Clamp() for double scroll offsets
+    if (offset > maxOffset) offset = maxOffset;
+    return offset < 0.0 ? 0.0 : offset;
+}
+
+static float rui_panel_screen_y(double contentY) { // screen y of a content-space position in the active panel
+    return rui_layout->currentPanel.y + rui_layout->panelHeaderHeight + (float)(contentY - rui_layout->scrollOffset);
+}
+
+static float rui_panel_place_y(void) { // screen y of the next auto-layout widget
+    return rui_panel_screen_y(rui_layout->panelCursorY);
+}
+
+static void rui_panel_advance(double height) { // move the layout cursor and grow the content height
+    rui_layout->panelCursorY += height;
+    rui_layout->contentHeight = rui_layout->panelCursorY;
+}
+
+static void rui_panel_scroll_load(unsigned int id) { // swap this panel's scroll state into the layout fields
+    rui_layout_state *l = rui_layout;
+    int slot = -1;
+    for (int i = 0; i < RUI_SCROLL_PANELS; ++i) {
+        if (l->scrollPanels[i].used != 0 && l->scrollPanels[i].id == id) { slot = i; break; }
+        if (slot < 0 || l->scrollPanels[i].used < l->scrollPanels[slot].used) slot = i; // free or least recently drawn
+    }
+    rui_panel_scroll *entry = &l->scrollPanels[slot];
+    if (entry->used == 0 || entry->id != id) *entry = (rui_panel_scroll){ .id = id }; // new panel starts at the top
+    entry->used = ++l->scrollTick;
+    l->scrollSlot = slot;
+    l->scrollOffset = entry->offset;
+    l->prevContentHeight = entry->prevContentHeight;
+    l->hasPrevContent = entry->hasPrevContent;
+    l->draggingScrollbar = entry->dragging;
+    l->dragOffsetY = entry->dragOffsetY;
+    l->scrollVelocity = entry->velocity;
+    l->scrollAccumulator = entry->accumulator;
+}
+
+static void rui_panel_scroll_store(void) { // keep the active scrollable panel's state for its next begin
+    rui_layout_state *l = rui_layout;
+    rui_panel_scroll *entry = &l->scrollPanels[l->scrollSlot];
+    entry->offset = l->scrollOffset;
+    entry->prevContentHeight = l->prevContentHeight;
+    entry->hasPrevContent = l->hasPrevContent;
+    entry->dragging = l->draggingScrollbar;
+    entry->dragOffsetY = l->dragOffsetY;
+    entry->velocity = l->scrollVelocity;
+    entry->accumulator = l->scrollAccumulator;
+}
+
+static void rui_panel_begin_internal(Rectangle bounds, const char *title, bool scrollable, rui_panel_style style, float alpha) {
+    if (!rui_ctx->skin) {
+        rui_theme_reset();
+    }
+
+    rui_layout->panelAlphaApplied = false;
+    float clampedAlpha = rui_clamp01(alpha);
+    if (clampedAlpha != 1.0f) {
+        rui_push_alpha(clampedAlpha);
+        rui_layout->panelAlphaApplied = true;
+    }
+
+    rui_layout->currentPanel = bounds; // remember panel rectangle for children
+    rui_layout->panelId = rui_hash_string(title, 0);
+    rui_layout->panelHasTitle = (title != NULL); // store whether title bar exists
+    rui_layout->panelPadding = rui_ctx->skin->metrics.padding; // scaled once per scale change
+    rui_layout->panelSpacing = rui_ctx->skin->metrics.spacing;
+    rui_layout->panelHeaderHeight = rui_calculate_header_height(rui_layout->panelHasTitle);
+    rui_layout->panelCursorY = rui_layout->panelPadding; // content space starts under the header
+    rui_layout->contentHeight = 0; // reset content height for this frame
+    rui_layout->panelActive = true; // mark panel as active for child widgets
+    rui_layout->panelScrollable = scrollable; // store whether scrolling is enabled
+    rui_layout->currentPanelStyle = style; // store style for child widgets rendered this frame
+    rui_layout->scrollOffsetBeforePanel = rui_layout->scrollOffset; // remember incoming scroll offset so it can be restored for other panels
+    if (scrollable) rui_panel_scroll_load(rui_layout->panelId); // each scrollable panel glides and scrolls on its own
+
+    float scrollbarWidth = scrollable ? rui_ctx->skin->metrics.scrollbarWidth : 0.0f; // reserve space for scrollbar when needed
+    rui_layout->panelInnerLeft = rui_layout->currentPanel.x + rui_layout->panelPadding; // compute inner left boundary
+    rui_layout->panelInnerRight = rui_layout->currentPanel.x + rui_layout->currentPanel.width - rui_layout->panelPadding - scrollbarWidth; // inner right boundary after padding and scrollbar
+    if (rui_layout->panelInnerRight < rui_layout->panelInnerLeft) { // guard against inverted bounds
+        rui_layout->panelInnerRight = rui_layout->panelInnerLeft; // collapse to avoid negative widths
+    }
+    rui_layout->panelContentWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft; // default content width spans full interior
+
+    rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, bounds)); // entering/leaving a panel matters for cached panels
+    float viewHeight = bounds.height - rui_layout->panelHeaderHeight; // compute visible height excluding header
+    if (scrollable) { // only read scroll input for scrollable panels
+        float wheel = GetMouseWheelMove(); // get wheel delta for this frame
+        float decay = expf(-RUI_SCROLL_DAMPING * RUI_SCROLL_TIMESTEP); // velocity kept per fixed step
+        if (wheel != 0.0f && CheckCollisionPointRec(rui_ctx->mouse, bounds)) { // ensure cursor is over panel
+            rui_layout->scrollVelocity += wheel * rui_ctx->skin->metrics.scrollStep * (1.0f - decay) / RUI_SCROLL_TIMESTEP; // the steps sum to one scroll step per notch (less the rest-speed cutoff)
+        }
+
+        double maxOffset = rui_layout->prevContentHeight - viewHeight; // maximum scroll based on previous content
+        if (rui_layout->draggingScrollbar || rui_layout->scrollVelocity == 0.0f) {
+            rui_layout->scrollAccumulator = 0.0f; // nothing to integrate: don't bank time for a later burst
+        } else {
+            rui_layout->scrollAccumulator += rui_ctx->frameDelta;
+            while (rui_layout->scrollAccumulator >= RUI_SCROLL_TIMESTEP) { // fixed steps: same path at 30 and 240 FPS
+                rui_layout->scrollAccumulator -= RUI_SCROLL_TIMESTEP;
+                rui_layout->scrollOffset += rui_layout->scrollVelocity * RUI_SCROLL_TIMESTEP;
+                rui_layout->scrollVelocity *= decay;
+                if (rui_layout->scrollOffset < 0.0 || (rui_layout->hasPrevContent && rui_layout->scrollOffset > fmax(maxOffset, 0.0))) {
+                    rui_layout->scrollVelocity = 0.0f; // hit an end: stop instead of pressing against it
+                    break;
+                }
+            }
+            if (fabsf(rui_layout->scrollVelocity) < RUI_SCROLL_REST_SPEED) rui_layout->scrollVelocity = 0.0f; // settled
+        }
+
+        if (maxOffset > 0) { // clamp only when content exceeds view
+            rui_layout->scrollOffset = rui_clamp_offset(rui_layout->scrollOffset, maxOffset); // keep scroll offset within bounds
+        } else if (rui_layout->hasPrevContent) { // if previous content was smaller, reset offset
+            rui_layout->scrollOffset = 0; // snap back to top when nothing to scroll
+        }
+    } else { // non-scrollable panels temporarily reset offset during their draw
+        rui_layout->scrollOffset = 0; // use zero offset for content placement
+    }
+
+    rui_layout->panelCacheEntry = NULL; // panels are uncached unless rui_panel_cache_next asked otherwise
+    rui_layout->panelCacheHit = false;
+    if (rui_layout->panelCacheRequested) {
+        rui_panel_cache_prepare(bounds, title, style); // blit, capture into texture, or fall back to live drawing
+        rui_layout->panelCacheRequested = false;
+    }
+    if (rui_layout->panelCacheHit) { // cached pixels already contain chrome and contents
+        rui_layout->panelClosePressed = false; // cursor is outside the panel, so the close button cannot be pressed
+        rui_layout->panelCloseRequested = false;
+        rui_layout->panelCloseLabel = NULL;
+        return;
+    }
+
+    rui_panel_ex(bounds, title, style); // draw panel chrome before clipping contents
+
+    if (rui_layout->panelCloseRequested && rui_layout->panelHasTitle) { // optionally draw close button on title bar
+        float buttonSize = rui_ctx->skin->metrics.closeButton;
+        Rectangle closeBounds = {
+            bounds.x + bounds.width - buttonSize - rui_ctx->skin->metrics.headerPadding,
+            bounds.y + (rui_layout->panelHeaderHeight - buttonSize) * 0.5f,
+            buttonSize,
+            buttonSize
+        };
+        rui_layout->panelClosePressed = rui_draw_close_button(closeBounds, rui_layout->panelCloseLabel, style.borderColor);
+    } else {
+        rui_layout->panelClosePressed = false;
+    }
+    rui_layout->panelCloseRequested = false; // clear request flag
+    rui_layout->panelCloseLabel = NULL; // reset custom label
+
+    rui_draw_scissor_begin((Rectangle){ bounds.x,
+                                        bounds.y + rui_layout->panelHeaderHeight,
+                                        bounds.width,
+                                        bounds.height - rui_layout->panelHeaderHeight }); // clip subsequent draws to panel interior
+}
+
+void rui_panel_begin(Rectangle bounds, const char *title, bool scrollable) { // start a managed panel with default style
+    rui_panel_begin_internal(bounds, title, scrollable, rui_ctx->panelStyleDefault, 1.0f);
+}
+
+void rui_panel_begin_ex(Rectangle bounds, const char *title, bool scrollable, rui_panel_style style) { // start panel with custom style
+    rui_panel_begin_internal(bounds, title, scrollable, style, 1.0f);
+}
+
+void rui_panel_begin_fade(Rectangle bounds, const char *title, bool scrollable, float alpha) { // start default panel with fade alpha
+    rui_panel_begin_internal(bounds, title, scrollable, rui_ctx->panelStyleDefault, alpha);
+}
+
+void rui_panel_begin_ex_fade(Rectangle bounds, const char *title, bool scrollable, rui_panel_style style, float alpha) { // start styled panel with fade alpha
+    rui_panel_begin_internal(bounds, title, scrollable, style, alpha);
+}
+
+bool rui_panel_button(const char *text, float height) { // add button within active panel
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit) return false; // guard when called outside panel pair
+
+    float innerWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft; // effective interior width
+    float targetWidth = rui_layout->panelContentWidth; // requested width for widgets
+    if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp width to interior
+
+    float x = rui_layout->panelInnerLeft; // default to left alignment
+    if (targetWidth < innerWidth) { // adjust based on alignment when there is spare space
+        if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
+            x = rui_layout->panelInnerLeft + (innerWidth - targetWidth) * 0.5f; // center within interior
+        } else if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
+            x = rui_layout->panelInnerRight - targetWidth; // stick to right edge
+        }
+    }
+
+    Rectangle r = { // compute button rectangle inside panel
+        x, // horizontal placement based on alignment
+        rui_panel_place_y(), // viewport-relative, so scroll depth never costs precision
+        targetWidth, // width respects alignment settings
+        height // use provided height for button box
+    };
+
+    rui_panel_advance(height + rui_layout->panelSpacing); // advance layout cursor for next widget
+
+    return rui_button(text, r); // draw button and return click state
+}
+
+bool rui_panel_button_call(const char *text, float height, void (*callback)(void *), void *userData) { // panel-aware button that fires callback
+    bool pressed = rui_panel_button(text, height); // draw button via layout helper
+    if (pressed && callback) { // fire callback when pressed
+        callback(userData); // forward user data pointer to callback
+    }
+    return pressed; // surface pressed status to caller
+}
+
+bool rui_panel_button_call_async(const char *text, float height, rui_job *job, void (*callback)(void *), void *userData) { // panel button whose callback runs on the pool
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit) return false;
+
+    float innerWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft; // usable width
+    float targetWidth = rui_layout->panelContentWidth; // requested width
+    if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp width
+
+    float x = rui_layout->panelInnerLeft; // base x coordinate
+    if (targetWidth < innerWidth) {
+        if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
+            x = rui_layout->panelInnerLeft + (innerWidth - targetWidth) * 0.5f;
+        } else if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
+            x = rui_layout->panelInnerRight - targetWidth;
+        }
+    }
+
+    Rectangle bounds = { x, rui_panel_place_y(), targetWidth, height };
+    rui_panel_advance(height + rui_layout->panelSpacing);
+    return rui_button_call_async(text, bounds, job, callback, userData);
+}
+
+void rui_panel_label(const char *text) { // add label within active panel using style color
+    rui_panel_label_color(text, rui_layout->currentPanelStyle.labelColor); // defer to color-aware helper with style default
+}
+
+void rui_panel_label_color(const char *text, Color color) { // add label within active panel using explicit color
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit) return; // ignore calls when no panel is active
+
+    float innerWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft; // width available inside panel
+    float targetWidth = rui_layout->panelContentWidth; // requested content width
+    if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp to interior
+
+    float containerX = rui_layout->panelInnerLeft; // default placement starts at inner left
+    if (targetWidth < innerWidth) { // adjust container placement when width narrower than available
+        if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
+            containerX = rui_layout->panelInnerLeft + (innerWidth - targetWidth) * 0.5f; // center container
+        } else if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
+            containerX = rui_layout->panelInnerRight - targetWidth; // anchor to right
+        }
+    }
+
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    Vector2 textSize = MeasureTextEx(fs->font, text, (float)fs->size, fs->spacing);
+    float textX = containerX; // default left alignment
+    if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
+        float offset = (targetWidth - textSize.x) * 0.5f; // center text inside container
+        if (offset < 0.0f) offset = 0.0f; // prevent negative offset when text wider than container
+        textX = containerX + offset; // apply centering offset
+    } else if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
+        float offset = targetWidth - textSize.x; // align text against right edge
+        if (offset < 0.0f) offset = 0.0f; // clamp when text wider than container
+        textX = containerX + offset; // place text near right boundary
+    }
+
+    float textY = rui_panel_place_y();
+    rui_draw_text(fs->font,
+               text,
+               (Vector2){ textX, textY },
+               (float)fs->size,
+               fs->spacing,
+               color);
+    rui_damage_track((Rectangle){ textX, textY, textSize.x, textSize.y },
+                     rui_hash_bytes(&color, (int)sizeof(color), rui_hash_string(text, 0)));
+
+    rui_panel_advance(textSize.y + rui_layout->panelSpacing); // move layout cursor past label height
+}
+
+void rui_panel_spacer(float height) { // insert vertical space inside active panel
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit) return; // only operate inside a panel
+    rui_panel_advance(height); // advance layout cursor by requested gap
+}
+
+void rui_panel_skip(double height) { // reserve content without emitting widgets (virtualized lists)
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit) return;
+    rui_panel_advance(height);
+}
+
+double rui_panel_cursor(void) { // content-space y where the next widget will be placed
+    return rui_layout->panelCursorY;
+}
+
+void rui_panel_visible_range(double *top, double *bottom) { // content-space span currently inside the viewport
+    double start = rui_layout->panelActive ? rui_layout->scrollOffset : 0.0;
+    double view = rui_layout->panelActive ? rui_layout->currentPanel.height - rui_layout->panelHeaderHeight : 0.0;
+    if (top) *top = start;
+    if (bottom) *bottom = start + view;
+}
+
+void rui_panel_set_content_width(float width) { // override width used for subsequent widgets
+    if (width <= 0.0f) { // zero or negative restores full interior width
+        rui_layout->panelContentWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft; // reset to full width
+    } else {
+        float maxWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft; // maximum allowed width inside panel
+        if (width > maxWidth) width = maxWidth; // clamp to interior width
+        rui_layout->panelContentWidth = width; // store new target width
+    }
+}
+
+float rui_panel_slider(float height, float value, float minValue, float maxValue) { // slider integrated with panel layout
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit) { // bail when no active panel
+        if (rui_shared_owner()) rui_undoNext = NULL; // meant for this slider, not the next one drawn
+        return value;
+    }
+
+    float innerWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft; // available width
+    float targetWidth = rui_layout->panelContentWidth; // requested widget width
+    if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp to interior
+
+    float x = rui_layout->panelInnerLeft; // default placement at left
+    if (targetWidth < innerWidth) { // adjust for alignment when width smaller
+        if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
+            x = rui_layout->panelInnerLeft + (innerWidth - targetWidth) * 0.5f; // center slider
+        } else if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
+            x = rui_layout->panelInnerRight - targetWidth; // align to right edge
+        }
+    }
+
+    Rectangle bounds = { x, rui_panel_place_y(), targetWidth, height }; // slider rectangle
+    float newValue = rui_slider(bounds, value, minValue, maxValue); // draw slider using core helper
+
+    rui_panel_advance(height + rui_layout->panelSpacing); // advance cursor after slider
+
+    return newValue; // return possibly updated value
+}
+
+float rui_panel_slider_call(float height, float value, float minValue, float maxValue, void (*callback)(float, void *), void *userData) { // panel slider helper with callback
+    unsigned int widget = rui_change_panel_widget(); // before the slider moves the cursor
+    float newValue = rui_panel_slider(height, value, minValue, maxValue); // reuse layout slider
+    rui_change_float(callback, userData, widget, newValue, newValue != value, rui_layout->sliderHeld); // notify user when value changes
+    return newValue; // return slider value
+}
+
+bool rui_panel_toggle(bool value, const char *label) { // toggle integrated with panel layout
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit) { // ignore when no panel active
+        if (rui_shared_owner()) rui_undoNext = NULL; // meant for this toggle, not the next one drawn
+        return value;
+    }
+
+    float height = (float)rui_ctx->skin->metrics.textFont.size + rui_ctx->skin->metrics.togglePadding; // default toggle height from font
+    if (height < rui_ctx->skin->metrics.minToggleHeight) height = rui_ctx->skin->metrics.minToggleHeight;
+    float innerWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft; // usable width
+    float targetWidth = rui_layout->panelContentWidth; // requested width
+    if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp
+
+    float x = rui_layout->panelInnerLeft; // base x position
+    if (targetWidth < innerWidth) {
+        if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
+            x = rui_layout->panelInnerLeft + (innerWidth - targetWidth) * 0.5f;
+        } else if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
+            x = rui_layout->panelInnerRight - targetWidth;
+        }
+    }
+
+    Rectangle bounds = { x, rui_panel_place_y(), targetWidth, height }; // overall toggle bounds
+    bool newValue = rui_toggle(bounds, value, label); // draw toggle using base helper
+
+    rui_panel_advance(height + rui_layout->panelSpacing); // advance cursor
+
+    return newValue; // return toggle state
+}
+
+bool rui_panel_toggle_call(bool value, const char *label, void (*callback)(bool, void *), void *userData) { // panel toggle helper with callback
+    unsigned int widget = rui_change_panel_widget();
+    bool newValue = rui_panel_toggle(value, label); // draw toggle using layout helper
+    rui_change_bool(callback, userData, widget, newValue, newValue != value); // notify about state change
+    return newValue; // return toggle state
+}
+
+bool rui_panel_text_input(float height, rui_text_input *input) { // integrate text input with panel layout
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit) return false; // ignore when panel inactive
+
+    float innerWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft; // usable width
+    float targetWidth = rui_layout->panelContentWidth; // requested width
+    if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp width
+
+    float x = rui_layout->panelInnerLeft; // base x coordinate
+    if (targetWidth < innerWidth) {
+        if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
+            x = rui_layout->panelInnerLeft + (innerWidth - targetWidth) * 0.5f;
+        } else if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
+            x = rui_layout->panelInnerRight - targetWidth;
+        }
+    }
+
+    Rectangle bounds = { x, rui_panel_place_y(), targetWidth, height }; // text box bounds
+    bool changed = rui_text_input_box(bounds, input); // draw input and handle typing
+
+    rui_panel_advance(height + rui_layout->panelSpacing); // advance cursor after input field
+
+    return changed; // return whether text changed
+}
+
+bool rui_panel_text_input_call(float height, rui_text_input *input, void (*callback)(const char *, void *), void *userData) { // panel text box with change callback
+    bool changed = rui_panel_text_input(height, input);
+    if (input && input->buffer) rui_change_text(callback, userData, input, changed);
+    return changed;
+}
+
+bool rui_panel_begin_closable(Rectangle bounds, const char *title, bool scrollable, const char *closeLabel) { // begin default-styled closable panel
+    return rui_panel_begin_closable_fade(bounds, title, scrollable, 1.0f, closeLabel);
+}
+
+bool rui_panel_begin_ex_closable(Rectangle bounds, const char *title, bool scrollable, rui_panel_style style, const char *closeLabel) { // styled panel with close button
+    return rui_panel_begin_ex_closable_fade(bounds, title, scrollable, style, 1.0f, closeLabel);
+}
+
+bool rui_panel_begin_closable_fade(Rectangle bounds, const char *title, bool scrollable, float alpha, const char *closeLabel) {
+    rui_layout->panelCloseRequested = true;
+    rui_layout->panelCloseLabel = closeLabel;
+    rui_layout->panelClosePressed = false;
+    rui_panel_begin_fade(bounds, title, scrollable, alpha);
+    return rui_layout->panelClosePressed;
+}
+
+bool rui_panel_begin_ex_closable_fade(Rectangle bounds, const char *title, bool scrollable, rui_panel_style style, float alpha, const char *closeLabel) {
+    rui_layout->panelCloseRequested = true;
+    rui_layout->panelCloseLabel = closeLabel;
+    rui_layout->panelClosePressed = false;
+    rui_panel_begin_ex_fade(bounds, title, scrollable, style, alpha);
+    return rui_layout->panelClosePressed;
+}
+
+void rui_panel_end(void) { // finish panel rendering and handle scrollbars
+    if (rui_layout->panelActive) { // only proceed if a panel was begun
+        if (rui_layout->panelCacheHit) { // cached panel: nothing was drawn or clipped, keep scroll state untouched
+            if (!rui_layout->panelScrollable) rui_layout->scrollOffset = rui_layout->scrollOffsetBeforePanel; // same restore as live non-scrollable panels
+        } else {
+            rui_draw_scissor_end(); // stop clipping so scrollbar can draw outside content area
+
+            if (rui_layout->panelScrollable && rui_layout->contentHeight > (rui_layout->currentPanel.height - rui_layout->panelHeaderHeight)) { // only show scrollbar when needed
+                float viewHeight = rui_layout->currentPanel.height - rui_layout->panelHeaderHeight; // visible content height
+                double maxOffset = rui_layout->contentHeight - viewHeight; // maximum scroll offset possible
+                if (maxOffset < 0) maxOffset = 0; // guard against negatives (precision)
+
+                // Draw track + thumb
+                float ratio = (float)(viewHeight / rui_layout->contentHeight); // portion of content visible
+                float barHeight = fminf(fmaxf(viewHeight * ratio, rui_ctx->skin->metrics.scrollbarWidth), viewHeight); // proportional, but still grabbable on huge content
+                float trackY = rui_layout->currentPanel.y + rui_layout->panelHeaderHeight; // scrollbar track start at content top
+                float travel = viewHeight - barHeight; // distance thumb can travel along track
+
+                Rectangle scrollTrack = { // rectangle representing scrollbar track
+                    rui_layout->currentPanel.x + rui_layout->currentPanel.width - rui_ctx->skin->metrics.scrollbarInset, // align track to right edge
+                    trackY, // start track below panel header
+                    rui_ctx->skin->metrics.scrollbarThumb, // track width
+                    viewHeight // track height matches viewable content
+                };
+
+                float barY = trackY + (maxOffset > 0 ? (float)(rui_layout->scrollOffset / maxOffset) * travel : 0.0f); // thumb position based on scroll fraction
+                Rectangle scrollBar = {scrollTrack.x, barY, scrollTrack.width, barHeight}; // rectangle for draggable thumb
+
+                rui_draw_rect(scrollTrack, rui_apply_alpha(LIGHTGRAY)); // draw track background
+                bool hovered = rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, scrollBar)); // detect hover over thumb
+                Color barColor = rui_layout->draggingScrollbar ? BLUE : (hovered ? GRAY : DARKGRAY); // change color when dragging or hovered
+                int thumb = rui_draw_rect(scrollBar, rui_apply_alpha(barColor)); // draw thumb with computed color
+                if (!rui_layout->draggingScrollbar) rui_draw_patch_add(thumb, scrollBar, rui_apply_alpha(DARKGRAY), rui_apply_alpha(GRAY), NULL);
+                rui_damage_track(scrollTrack, rui_hash_bytes(&barColor, (int)sizeof(barColor), rui_hash_float(barY, rui_hash_float(barHeight, 0))));
+
+                // Drag input
+                if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && hovered) { // start dragging when thumb clicked
+                    rui_layout->draggingScrollbar = true; // flag dragging state
+                    rui_layout->dragOffsetY = rui_ctx->mouse.y - scrollBar.y; // remember grab offset within thumb
+                    rui_layout->scrollVelocity = 0.0f; // grabbing stops any glide
+                }
+
+                if (rui_layout->draggingScrollbar) { // while in drag mode
+                    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) { // continue while button is held
+                        float newBarY = rui_ctx->mouse.y - rui_layout->dragOffsetY; // proposed thumb position following mouse
+                        newBarY = Clamp(newBarY, trackY, trackY + travel); // constrain thumb to track bounds
+                        if (travel > 0) { // avoid divide-by-zero when no travel
+                            double previousOffset = rui_layout->scrollOffset;
+                            rui_layout->scrollOffset = ((double)(newBarY - trackY) / travel) * maxOffset; // convert thumb position to scroll offset
+                            float dt = rui_ctx->frameDelta;
+                            if (dt > 0.0f) { // smoothed drag speed becomes the glide speed on release
+                                float instant = (float)((rui_layout->scrollOffset - previousOffset) / dt);
+                                float blend = 1.0f - expf(-dt / RUI_SCROLL_FLICK_SMOOTHING);
+                                rui_layout->scrollVelocity += (instant - rui_layout->scrollVelocity) * blend;
+                            }
+                        }
+                    } else { // mouse button released
+                        rui_layout->draggingScrollbar = false; // exit dragging state; scrollVelocity carries on as inertia
+                    }
+                }
+
+                // ✅ Final clamp for both drag + wheel
+                rui_layout->scrollOffset = rui_clamp_offset(rui_layout->scrollOffset, maxOffset); // enforce valid offset after interactions
+            } else {
+                if (rui_layout->panelScrollable) { // scrollable panel with no overflow resets offset
+                    rui_layout->scrollOffset = 0; // keep offset zero when content fits
+                } else { // restore prior offset after non-scrollable panels so other panels retain their position
+                    rui_layout->scrollOffset = rui_layout->scrollOffsetBeforePanel; // reinstate offset saved at begin
+                }
+            }
+        }
+
+        if (rui_layout->panelScrollable) { // only update prev height for scrollable panels
+            rui_layout->prevContentHeight = rui_layout->contentHeight; // store current content height for next frame
+            rui_layout->hasPrevContent = true; // mark that we now have previous content data
+            rui_panel_scroll_store();
+        }
+        if (rui_layout->panelCacheEntry) { // finish capture and blit before the panel alpha is popped
+            rui_panel_cache_finish();
+        }
+        rui_layout->panelActive = false; // clear active flag until next panel begin
+        rui_layout->panelContentWidth = 0.0f; // reset content width override after finishing panel
+
+        if (rui_layout->panelAlphaApplied) {
+            rui_pop_alpha();
+            rui_layout->panelAlphaApplied = false;
+        }
+    }
+}
+
+// --- Selection Sets ---
+void rui_selection_init(rui_selection *selection) {
+    if (!selection) return;
+    *selection = (rui_selection){ 0 };
+    selection->anchor = -1;
+}
+
+void rui_selection_free(rui_selection *selection) {
+    if (!selection) return;
+    rui_free(selection->runs);
+    rui_selection_init(selection);
+}
+
+void rui_selection_clear(rui_selection *selection) {
+    if (!selection || selection->runCount == 0) return;
+    selection->runCount = 0;
+    selection->count = 0;
+    selection->revision++;
+}
+
+static int rui_selection_find(const rui_selection *selection, long value, int field) { // first run whose start (0) or end (1) is >= value
+    int lo = 0, hi = selection->runCount;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (selection->runs[2 * mid + field] < value) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static bool rui_selection_splice(rui_selection *selection, int first, int last, const long *replacement, int replacementCount) { // runs[first..last) -> replacement
+    int runCount = selection->runCount - (last - first) + replacementCount;
+    long *runs = (long *)rui_grow(selection->runs, &selection->capacity, runCount, (int)(2 * sizeof(long)));
+    if (!runs) return false;
+    selection->runs = runs;
+    for (int i = first; i < last; ++i) selection->count -= runs[2 * i + 1] - runs[2 * i];
+    memmove(runs + 2 * (first + replacementCount), runs + 2 * last, (size_t)(selection->runCount - last) * 2 * sizeof(long));
+    for (int i = 0; i < replacementCount; ++i) {
+        runs[2 * (first + i)] = replacement[2 * i];
+        runs[2 * (first + i) + 1] = replacement[2 * i + 1];
+        selection->count += replacement[2 * i + 1] - replacement[2 * i];
+    }
+    selection->runCount = runCount;
+    selection->revision++;
+    return true;
+}
+
+void rui_selection_set(rui_selection *selection, long start, long end, bool selected) {
+    if (!selection || start < 0 || end <= start) return;
+    long replacement[4];
+    int count = 0, first, last;
+    if (selected) { // absorb every run that overlaps or touches the range
+        first = rui_selection_find(selection, start, 1);
+        last = rui_selection_find(selection, end + 1, 0);
+        replacement[0] = first < last && selection->runs[2 * first] < start ? selection->runs[2 * first] : start;
+        replacement[1] = first < last && selection->runs[2 * (last - 1) + 1] > end ? selection->runs[2 * (last - 1) + 1] : end;
+        count = 1;
+        if (last - first == 1 && replacement[0] == selection->runs[2 * first] && replacement[1] == selection->runs[2 * first + 1]) return; // already inside one run
+    } else { // cut the range out, keeping the pieces of the runs at either edge
+        first = rui_selection_find(selection, start + 1, 1);
+        last = rui_selection_find(selection, end, 0);
+        if (first >= last) return; // nothing selected in the range
+        if (selection->runs[2 * first] < start) {
+            replacement[2 * count] = selection->runs[2 * first];
+            replacement[2 * count + 1] = start;
+            count++;
+        }
+        if (selection->runs[2 * (last - 1) + 1] > end) {
+            replacement[2 * count] = end;
+            replacement[2 * count + 1] = selection->runs[2 * (last - 1) + 1];
+            count++;
+        }
+    }
+    rui_selection_splice(selection, first, last, replacement, count);
+}
+
+void rui_selection_all(rui_selection *selection, long count) {
+    if (!selection) return;
+    rui_selection_clear(selection);
+    rui_selection_set(selection, 0, count, true);
+}
+
+bool rui_selection_contains(rui_selection *selection, long index) {
+    if (!selection || selection->runCount == 0) return false;
+    int run = selection->hint;
+    if (run >= selection->runCount) run = selection->runCount - 1;
+    if (index >= selection->runs[2 * run] && index < selection->runs[2 * run + 1]) return true; // same run as last time
+    if (run + 1 < selection->runCount && index >= selection->runs[2 * run + 1] && index < selection->runs[2 * (run + 1)]) return false; // gap after it
+    if (run + 1 < selection->runCount && index >= selection->runs[2 * (run + 1)] && index < selection->runs[2 * (run + 1) + 1]) {
+        selection->hint = run + 1; // rows drawn in order step into the next run
+        return true;
+    }
+    run = rui_selection_find(selection, index + 1, 1); // first run ending after index
+    if (run >= selection->runCount) {
+        selection->hint = selection->runCount - 1;
+        return false;
+    }
+    selection->hint = run;
+    return selection->runs[2 * run] <= index;
+}
+
+void rui_selection_toggle(rui_selection *selection, long index) {
+    if (!selection || index < 0) return;
+    rui_selection_set(selection, index, index + 1, !rui_selection_contains(selection, index));
+}
+
+long rui_selection_next(const rui_selection *selection, long from) {
+    if (!selection) return -1;
+    if (from < 0) from = 0;
+    int run = rui_selection_find(selection, from + 1, 1);
+    if (run >= selection->runCount) return -1;
+    return selection->runs[2 * run] > from ? selection->runs[2 * run] : from;
+}
+
+void rui_selection_click(rui_selection *selection, long index, bool extend, bool toggle) {
+    if (!selection || index < 0) return;
+    if (extend) { // shift: anchor to index (ctrl+shift adds to what is already selected)
+        long anchor = selection->anchor >= 0 ? selection->anchor : index;
+        if (!toggle) rui_selection_clear(selection);
+        rui_selection_set(selection, anchor < index ? anchor : index, (anchor > index ? anchor : index) + 1, true);
+        selection->anchor = anchor;
+        return;
+    }
+    if (toggle) rui_selection_toggle(selection, index);
+    else {
+        rui_selection_clear(selection);
+        rui_selection_set(selection, index, index + 1, true);
+    }
+    selection->anchor = index;
+}
+
+// --- Tables ---
+// Rows are placed through the panel's content space and columns through scrollX, and only the cells inside
+// both ranges are pulled from the cell callback, so a million-row table costs the same as a small one.
+void rui_table_init(rui_table *table, rui_table_column *columns, int columnCount, long rowCount, rui_table_cell_fn cell, void *userData) {
+    *table = (rui_table){ 0 };
+    table->columns = columns;
+    table->columnCount = columnCount;
+    table->rowCount = rowCount;
+    table->cell = cell;
+    table->userData = userData;
+    table->selectedRow = -1;
+    table->hoveredRow = -1;
+    table->resizingColumn = -1;
+}
+
+static unsigned int rui_table_cells(const rui_table *table, int column, Rectangle clip, float x, double rowsTop, float rowHeight, long first, long last, unsigned int hash) { // text of one column's visible cells
+    if (clip.width <= 0.0f || clip.height <= 0.0f) return hash;
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    Color textColor = rui_apply_alpha(rui_ctx->skin->theme.textInput.text);
+    char buffer[128]; // scratch for cells formatted from values
+    rui_draw_scissor_begin(clip);
+    for (long row = first; row < last; ++row) {
+        buffer[0] = '\0';
+        const char *text = table->cell ? table->cell(row, column, buffer, (int)sizeof(buffer), table->userData) : NULL;
+        if (!text || !text[0]) continue;
+        float y = rui_panel_screen_y(rowsTop + (double)row * rowHeight) + (rowHeight - (float)fs->size) * 0.5f;
+        rui_draw_text(fs->font, text, (Vector2){ x + rui_ctx->skin->metrics.textInset, y }, (float)fs->size, fs->spacing, textColor);
+        hash = rui_hash_string(text, hash);
+    }
+    rui_draw_rect((Rectangle){ x + table->columns[column].width - rui_ctx->skin->metrics.hairline, clip.y, rui_ctx->skin->metrics.hairline, clip.height },
+                  rui_apply_alpha(rui_ctx->skin->theme.button.border)); // column separator
+    return hash;
+}
+
+static void rui_table_header(const rui_table *table, int column, Rectangle clip, float x, float y, float rowHeight) { // one header cell
+    if (clip.width <= 0.0f || clip.height <= 0.0f) return;
+    const rui_button_style *bs = &rui_ctx->skin->theme.button;
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    Rectangle cell = { x, y, table->columns[column].width, rowHeight };
+    rui_draw_scissor_begin(clip);
+    rui_draw_rect(cell, rui_apply_alpha(table->resizingColumn == column ? bs->hover : bs->normal));
+    rui_draw_rect_lines(cell, rui_ctx->skin->metrics.hairline, rui_apply_alpha(bs->border));
+    if (table->columns[column].title) {
+        rui_draw_text(fs->font, table->columns[column].title,
+                      (Vector2){ x + rui_ctx->skin->metrics.textInset, y + (rowHeight - (float)fs->size) * 0.5f },
+                      (float)fs->size, fs->spacing, rui_apply_alpha(bs->text));
+    }
+}
+
+long rui_panel_table(rui_table *table) { // virtualized table filling one block of the active panel
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit || !table) return -1;
+
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    float rowHeight = table->rowHeight > 0.0f ? table->rowHeight : (float)fs->size + 2.0f * rui_ctx->skin->metrics.textInset;
+    float left = rui_layout->panelInnerLeft;
+    float viewWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft;
+    bool sticky = table->stickyFirstColumn && table->columnCount > 0;
+    float stickyWidth = sticky ? fminf(table->columns[0].width, viewWidth) : 0.0f;
+    float scrollLeft = left + stickyWidth; // non-sticky columns live in [scrollLeft, left + viewWidth)
+    float scrollWidth = viewWidth - stickyWidth;
+    float totalWidth = 0.0f;
+    for (int c = sticky ? 1 : 0; c < table->columnCount; ++c) totalWidth += table->columns[c].width;
+    float maxScrollX = fmaxf(totalWidth - scrollWidth, 0.0f);
+    float barHeight = maxScrollX > 0.0f ? rui_ctx->skin->metrics.scrollbarThumb : 0.0f; // horizontal scrollbar strip under the last row
+
+    double top = rui_layout->panelCursorY; // table top in content space
+    double rowsTop = top + rowHeight;
+    double height = (double)rowHeight * ((double)table->rowCount + 1.0) + barHeight;
+    rui_panel_advance(height + rui_layout->panelSpacing); // claim the whole table, visible or not
+
+    Rectangle viewport = { rui_layout->currentPanel.x, rui_layout->currentPanel.y + rui_layout->panelHeaderHeight,
+                           rui_layout->currentPanel.width, rui_layout->currentPanel.height - rui_layout->panelHeaderHeight };
+    float tableTopY = rui_panel_screen_y(top);
+    float tableBottomY = rui_panel_screen_y(top + height);
+    float visibleTop = fmaxf(tableTopY, viewport.y);
+    float visibleBottom = fminf(tableBottomY, viewport.y + viewport.height);
+    table->hoveredRow = -1;
+    if (visibleBottom <= visibleTop || viewWidth <= 0.0f) return -1; // scrolled out of view: no cells pulled
+
+    float headerY = fminf(visibleTop, tableBottomY - barHeight - rowHeight); // sticky header, pushed up by the table's end
+    float barY = visibleBottom - barHeight; // sticky scrollbar at the bottom of the visible part
+    Rectangle body = { left, headerY + rowHeight, viewWidth, barY - (headerY + rowHeight) };
+    if (body.height < 0.0f) body.height = 0.0f;
+    Rectangle headerRect = GetCollisionRec((Rectangle){ left, headerY, viewWidth, rowHeight }, viewport);
+
+    // Horizontal scroll: trackpad wheel and thumb drag
+    Rectangle track = { scrollLeft, barY, scrollWidth, barHeight };
+    float thumbWidth = maxScrollX > 0.0f ? fmaxf(scrollWidth * scrollWidth / totalWidth, rui_ctx->skin->metrics.scrollbarWidth) : 0.0f;
+    float travel = fmaxf(scrollWidth - thumbWidth, 0.0f);
+    Rectangle visible = { left, visibleTop, viewWidth, visibleBottom - visibleTop };
+    bool hovered = rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, visible));
+    if (hovered && maxScrollX > 0.0f) table->scrollX += GetMouseWheelMoveV().x * rui_ctx->skin->metrics.scrollStep;
+    Rectangle thumb = { scrollLeft + (maxScrollX > 0.0f ? table->scrollX / maxScrollX * travel : 0.0f), barY, thumbWidth, barHeight };
+    bool thumbHovered = barHeight > 0.0f && rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, thumb));
+    if (thumbHovered && rui_ctx->mousePressed) {
+        table->draggingBar = true;
+        table->barGrab = rui_ctx->mouse.x - thumb.x;
+    }
+    if (table->draggingBar) {
+        if (IsMouseButtonDown(MOUSE_LEFT_BUTTON) && travel > 0.0f) {
+            table->scrollX = (rui_ctx->mouse.x - table->barGrab - scrollLeft) / travel * maxScrollX;
+        } else {
+            table->draggingBar = false;
+        }
+    }
+    table->scrollX = Clamp(table->scrollX, 0.0f, maxScrollX);
+    thumb.x = scrollLeft + (maxScrollX > 0.0f ? table->scrollX / maxScrollX * travel : 0.0f);
+
+    // Column resize: grab the right edge of a header cell
+    float grab = 2.0f * rui_ctx->skin->metrics.border + 2.0f;
+    if (table->resizingColumn < 0 && rui_ctx->mousePressed && CheckCollisionPointRec(rui_ctx->mouse, headerRect)) {
+        float x = scrollLeft - table->scrollX;
+        for (int c = 0; c < table->columnCount; ++c) {
+            float edge = (sticky && c == 0) ? left + stickyWidth : (x += table->columns[c].width);
+            if (fabsf(rui_ctx->mouse.x - edge) <= grab && ((sticky && c == 0) || edge > scrollLeft)) {
+                table->resizingColumn = c;
+                table->resizeAnchor = rui_ctx->mouse.x - table->columns[c].width;
+                break;
+            }
+            if (x > left + viewWidth + grab) break; // edges further right are off-screen
+        }
+    }
+    if (table->resizingColumn >= 0) {
+        if (IsMouseButtonDown(MOUSE_LEFT_BUTTON) && table->resizingColumn < table->columnCount) {
+            rui_table_column *column = &table->columns[table->resizingColumn];
+            float minWidth = column->minWidth > 0.0f ? column->minWidth : 4.0f * rui_ctx->skin->metrics.textInset;
+            column->width = fmaxf(rui_ctx->mouse.x - table->resizeAnchor, minWidth);
+        } else {
+            table->resizingColumn = -1;
+        }
+    }
+    if (table->resizingColumn >= 0 || table->draggingBar) {
+        rui_layout->activity = true; // drags follow the cursor
+        rui_layout->panelCacheDirty = true;
+    }
+
+    // Visible row range from the body's content-space span
+    double bodyTop = rui_layout->scrollOffset + (body.y - viewport.y) - rowsTop;
+    double bodyBottom = rui_layout->scrollOffset + (body.y + body.height - viewport.y) - rowsTop;
+    long first = (long)fmax(0.0, floor(bodyTop / rowHeight));
+    long last = (long)fmin((double)table->rowCount, ceil(bodyBottom / rowHeight));
+    long clicked = -1;
+    if (CheckCollisionPointRec(rui_ctx->mouse, body) && table->resizingColumn < 0 && !table->draggingBar) {
+        double row = floor((rui_layout->scrollOffset + (rui_ctx->mouse.y - viewport.y) - rowsTop) / rowHeight);
+        if (row >= 0.0 && row < (double)table->rowCount) table->hoveredRow = (long)row;
+        if (table->hoveredRow >= 0 && rui_ctx->mousePressed && !thumbHovered) {
+            clicked = table->hoveredRow;
+            table->selectedRow = clicked;
+            if (table->selection) {
+                bool toggle = IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL) || IsKeyDown(KEY_LEFT_SUPER) || IsKeyDown(KEY_RIGHT_SUPER);
+                bool extend = IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT);
+                rui_selection_click(table->selection, clicked, extend, toggle);
+            }
+        }
+        bool command = IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL) || IsKeyDown(KEY_LEFT_SUPER) || IsKeyDown(KEY_RIGHT_SUPER);
+        if (table->selection && command && IsKeyPressed(KEY_A) && !rui_ctx->keyboardCaptured) {
+            rui_selection_all(table->selection, table->rowCount);
+            rui_layout->activity = true;
+        }
+    }
+
+    // Row backgrounds; hover follows the cursor on replayed frames like buttons
+    const rui_button_style *bs = &rui_ctx->skin->theme.button;
+    rui_draw_scissor_begin(body);
+    for (long row = first; row < last; ++row) {
+        Rectangle r = { left, rui_panel_screen_y(rowsTop + (double)row * rowHeight), viewWidth, rowHeight };
+        bool selected = table->selection ? rui_selection_contains(table->selection, row) : row == table->selectedRow;
+        Color normal = rui_apply_alpha(selected ? bs->pressed : rui_ctx->skin->theme.textInput.background);
+        int fill = rui_draw_rect(r, row == table->hoveredRow ? rui_apply_alpha(bs->hover) : normal);
+        rui_draw_patch_add(fill, GetCollisionRec(r, body), normal, rui_apply_alpha(bs->hover), NULL);
+    }
+
+    // Cells, then the header on top, column by column so each column is one scissor
+    unsigned int hash = rui_hash_float(table->scrollX, rui_hash_int((int)first, rui_hash_int((int)last, rui_hash_float(headerY, 0))));
+    hash = rui_hash_int((int)table->selectedRow, rui_hash_int((int)table->hoveredRow, rui_hash_int(table->resizingColumn, hash)));
+    if (table->selection) hash = rui_hash_int((int)table->selection->revision, hash);
+    Rectangle scrollBody = GetCollisionRec(body, (Rectangle){ scrollLeft, body.y, scrollWidth, body.height });
+    Rectangle scrollHeader = GetCollisionRec(headerRect, (Rectangle){ scrollLeft, headerRect.y, scrollWidth, headerRect.height });
+    float x = scrollLeft - table->scrollX;
+    for (int c = sticky ? 1 : 0; c < table->columnCount && x < left + viewWidth; ++c) {
+        float width = table->columns[c].width;
+        if (x + width > scrollLeft) {
+            Rectangle column = { x, body.y, width, body.height };
+            hash = rui_table_cells(table, c, GetCollisionRec(column, scrollBody), x, rowsTop, rowHeight, first, last, rui_hash_float(width, hash));
+            rui_table_header(table, c, GetCollisionRec((Rectangle){ x, headerY, width, rowHeight }, scrollHeader), x, headerY, rowHeight);
+        }
+        x += width;
+    }
+    if (sticky) {
+        Rectangle column = { left, body.y, stickyWidth, body.height };
+        hash = rui_table_cells(table, 0, GetCollisionRec(column, body), left, rowsTop, rowHeight, first, last, rui_hash_float(stickyWidth, hash));
+        rui_table_header(table, 0, GetCollisionRec((Rectangle){ left, headerY, stickyWidth, rowHeight }, headerRect), left, headerY, rowHeight);
+    }
+
+    if (barHeight > 0.0f) {
+        rui_draw_scissor_begin(viewport);
+        rui_draw_rect(track, rui_apply_alpha(LIGHTGRAY));
+        Color thumbColor = table->draggingBar ? BLUE : (thumbHovered ? GRAY : DARKGRAY); // same colours as the panel scrollbar
+        int bar = rui_draw_rect(thumb, rui_apply_alpha(thumbColor));
+        if (!table->draggingBar) rui_draw_patch_add(bar, thumb, rui_apply_alpha(DARKGRAY), rui_apply_alpha(GRAY), NULL);
+        hash = rui_hash_float(thumb.x, hash);
+    }
+    rui_draw_scissor_begin(viewport); // scissors do not nest: restore the panel's clip
+    rui_damage_track(visible, hash);
+    return clicked;
+}
+
+// --- Sort & Filter ---
+// A coordinator task runs on the pool and fans filter, sort and merge slices out as further tasks. Key
+// extraction happens during the filter pass, numbers are LSD radix sorted on order-preserving bit images,
+// and strings are sorted per slice then merged in rounds, each merge split into equal slices by co-ranking.
+static int rui_sortPending = 0; // pool counter for every coordinator; the pool never touches a view once its job stored ready
+
+typedef struct rui_sort_item { // key/row pair moved together while sorting
+    union {
+        unsigned long long bits; // order-preserving image of a double
+        const char *text; // string key
+    } key;
+    long row; // data row; also breaks ties, so the order is total and deterministic
+} rui_sort_item;
+
+typedef struct rui_sort_chunk { // one task's slice
+    rui_sort_view *view; // owning view
+    long begin; // first row, item or output position
+    long end; // one past the last
+    long kept; // rows that passed the filter
+    const rui_sort_item *a; // merge input runs
+    const rui_sort_item *b;
+    long aCount;
+    long bCount;
+    rui_sort_item *out; // merge output run
+} rui_sort_chunk;
+
+void rui_sort_view_init(rui_sort_view *view) {
+    *view = (rui_sort_view){ 0 };
+}
+
+static void rui_sort_step(rui_sort_view *view, int units) { // progress bookkeeping
+    RUI_ATOMIC_ADD(&view->unitsDone, units);
+}
+
+static unsigned long long rui_sort_number_bits(double value, bool descending) { // unsigned compare == double compare
+    unsigned long long bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits = (bits >> 63) ? ~bits : bits | 0x8000000000000000ull;
+    return descending ? ~bits : bits;
+}
+
+static bool rui_sort_text_less(const rui_sort_item *x, const rui_sort_item *y, bool descending) {
+    int c = strcmp(x->key.text, y->key.text);
+    if (c != 0) return descending ? c > 0 : c < 0;
+    return x->row < y->row;
+}
+
+static int rui_sort_text_ascending(const void *x, const void *y) { // qsort comparators (no context argument)
+    return rui_sort_text_less((const rui_sort_item *)x, (const rui_sort_item *)y, false) ? -1 : 1;
+}
+
+static int rui_sort_text_descending(const void *x, const void *y) {
+    return rui_sort_text_less((const rui_sort_item *)x, (const rui_sort_item *)y, true) ? -1 : 1;
+}
+
+static void rui_sort_filter_task(void *arg) { // keep passing rows and extract their keys
+    rui_sort_chunk *chunk = (rui_sort_chunk *)arg;
+    rui_sort_view *view = chunk->view;
+    const rui_sort_request *request = &view->active;
+    chunk->kept = 0;
+    if (!RUI_ATOMIC_LOAD(&view->cancel)) {
+        for (long row = chunk->begin; row < chunk->end; ++row) {
+            if (request->filter && !request->filter(row, request->userData)) continue;
+            rui_sort_item *item = &view->items[chunk->begin + chunk->kept++];
+            item->row = row;
+            if (request->number) {
+                item->key.bits = rui_sort_number_bits(request->number(row, request->userData), request->descending);
+            } else if (request->text) {
+                const char *text = request->text(row, request->userData);
+                item->key.text = text ? text : "";
+            }
+        }
+    }
+    rui_sort_step(view, 1);
+}
+
+static void rui_sort_slice_task(void *arg) { // sort one slice of string keys
+    rui_sort_chunk *chunk = (rui_sort_chunk *)arg;
+    rui_sort_view *view = chunk->view;
+    if (!RUI_ATOMIC_LOAD(&view->cancel)) {
+        qsort(view->items + chunk->begin, (size_t)(chunk->end - chunk->begin), sizeof(rui_sort_item),
+              view->active.descending ? rui_sort_text_descending : rui_sort_text_ascending);
+    }
+    rui_sort_step(view, 1);
+}
+
+static long rui_sort_corank(long k, const rui_sort_chunk *chunk, bool descending) { // items taken from a among the first k merged
+    long lo = k > chunk->bCount ? k - chunk->bCount : 0;
+    long hi = k < chunk->aCount ? k : chunk->aCount;
+    while (lo < hi) {
+        long i = lo + (hi - lo) / 2;
+        if (rui_sort_text_less(&chunk->b[k - i - 1], &chunk->a[i], descending)) hi = i;
+        else lo = i + 1;
+    }
+    return lo;
+}
+
+static void rui_sort_merge_task(void *arg) { // merge output positions [begin, end) of two sorted runs
+    rui_sort_chunk *chunk = (rui_sort_chunk *)arg;
+    rui_sort_view *view = chunk->view;
+    if (!RUI_ATOMIC_LOAD(&view->cancel)) {
+        bool descending = view->active.descending;
+        long i = rui_sort_corank(chunk->begin, chunk, descending), iEnd = rui_sort_corank(chunk->end, chunk, descending);
+        long j = chunk->begin - i, jEnd = chunk->end - iEnd;
+        rui_sort_item *out = chunk->out + chunk->begin;
+        while (i < iEnd && j < jEnd) *out++ = rui_sort_text_less(&chunk->b[j], &chunk->a[i], descending) ? chunk->b[j++] : chunk->a[i++];
+        while (i < iEnd) *out++ = chunk->a[i++];
+        while (j < jEnd) *out++ = chunk->b[j++];
+    }
+    rui_sort_step(view, 1);
+}
+
+static void rui_sort_radix(rui_sort_view *view, long count, int unitsPerPass) { // stable LSD radix sort, 8 bits per pass
+    rui_sort_item *src = view->items, *dst = view->scratch;
+    for (int shift = 0; shift < 64 && !RUI_ATOMIC_LOAD(&view->cancel); shift += 8) {
+        long histogram[256] = { 0 };
+        for (long i = 0; i < count; ++i) histogram[(src[i].key.bits >> shift) & 255u]++;
+        if (histogram[(src[0].key.bits >> shift) & 255u] == count) { // every key shares this digit
+            rui_sort_step(view, unitsPerPass);
+            continue;
+        }
+        long offset = 0;
+        for (int d = 0; d < 256; ++d) {
+            long n = histogram[d];
+            histogram[d] = offset;
+            offset += n;
+        }
+        for (long i = 0; i < count; ++i) dst[histogram[(src[i].key.bits >> shift) & 255u]++] = src[i];
+        rui_sort_item *swap = src;
+        src = dst;
+        dst = swap;
+        rui_sort_step(view, unitsPerPass);
+    }
+    if (src != view->items) memcpy(view->items, src, (size_t)count * sizeof(rui_sort_item));
+}
+
+static void rui_sort_merge_rounds(rui_sort_view *view, long count) { // pairwise merges of sorted slices until one run is left
+    rui_sort_item *src = view->items, *dst = view->scratch;
+    for (long width = RUI_SORT_CHUNK; width < count && !RUI_ATOMIC_LOAD(&view->cancel); width *= 2) {
+        int pending = 0, tasks = 0;
+        for (long start = 0; start < count; start += 2 * width) {
+            long mid = start + width < count ? start + width : count;
+            long end = start + 2 * width < count ? start + 2 * width : count;
+            for (long k = start; k < end; k += RUI_SORT_CHUNK) { // slices start on RUI_SORT_CHUNK boundaries, so tasks <= chunk count
+                rui_sort_chunk *chunk = &view->chunks[tasks++];
+                *chunk = (rui_sort_chunk){ .view = view, .begin = k - start, .end = (k + RUI_SORT_CHUNK < end ? k + RUI_SORT_CHUNK : end) - start,
+                                           .a = src + start, .aCount = mid - start, .b = src + mid, .bCount = end - mid, .out = dst + start };
+                rui_task_submit(rui_sort_merge_task, chunk, &pending);
+            }
+        }
+        rui_task_wait(&pending);
+        rui_sort_item *swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != view->items) memcpy(view->items, src, (size_t)count * sizeof(rui_sort_item));
+}
+
+static void rui_sort_job(void *arg) { // coordinator: runs on a worker (or inline without RUI_THREADS)
+    rui_sort_view *view = (rui_sort_view *)arg;
+    const rui_sort_request *request = &view->active;
+    long rows = request->rowCount;
+    int slices = (int)((rows + RUI_SORT_CHUNK - 1) / RUI_SORT_CHUNK);
+    int rounds = 0;
+    for (long width = RUI_SORT_CHUNK; width < rows; width *= 2) rounds++;
+    int sortUnits = request->number ? 8 * (slices > 0 ? slices : 1) : (request->text ? slices * (1 + rounds) : 0);
+    RUI_ATOMIC_STORE(&view->unitsTotal, slices + sortUnits);
+
+    int pending = 0;
+    for (int c = 0; c < slices; ++c) {
+        rui_sort_chunk *chunk = &view->chunks[c];
+        *chunk = (rui_sort_chunk){ .view = view, .begin = (long)c * RUI_SORT_CHUNK };
+        chunk->end = chunk->begin + RUI_SORT_CHUNK < rows ? chunk->begin + RUI_SORT_CHUNK : rows;
+        rui_task_submit(rui_sort_filter_task, chunk, &pending);
+    }
+    rui_task_wait(&pending);
+
+    long count = 0;
+    for (int c = 0; c < slices; ++c) { // compact the kept rows of every slice
+        const rui_sort_chunk *chunk = &view->chunks[c];
+        if (chunk->begin != count) memmove(view->items + count, view->items + chunk->begin, (size_t)chunk->kept * sizeof(rui_sort_item));
+        count += chunk->kept;
+    }
+
+    if (count > 1 && request->number) {
+        rui_sort_radix(view, count, slices > 0 ? slices : 1);
+    } else if (count > 1 && request->text) {
+        int sorted = 0;
+        for (long begin = 0; begin < count; begin += RUI_SORT_CHUNK) {
+            rui_sort_chunk *chunk = &view->chunks[sorted++];
+            *chunk = (rui_sort_chunk){ .view = view, .begin = begin, .end = begin + RUI_SORT_CHUNK < count ? begin + RUI_SORT_CHUNK : count };
+            rui_task_submit(rui_sort_slice_task, chunk, &pending);
         }
+        rui_task_wait(&pending);
+        rui_sort_merge_rounds(view, count);
+    }
+
+    for (long i = 0; i < count; ++i) view->back[i] = view->items[i].row;
+    view->backCount = count;
+    RUI_ATOMIC_STORE(&view->ready, RUI_ATOMIC_LOAD(&view->cancel) ? 2 : 1); // publishes back to the UI thread
+}
+
+static bool rui_sort_view_reserve(rui_sort_view *view, long rows) { // grow every buffer together (UI thread, no job running)
+    if (rows <= view->capacity) return true;
+    long slices = (rows + RUI_SORT_CHUNK - 1) / RUI_SORT_CHUNK;
+    void *items = rui_realloc(view->items, (size_t)rows * sizeof(rui_sort_item));
+    if (!items) return false;
+    view->items = (rui_sort_item *)items;
+    void *scratch = rui_realloc(view->scratch, (size_t)rows * sizeof(rui_sort_item));
+    if (!scratch) return false;
+    view->scratch = (rui_sort_item *)scratch;
+    void *order = rui_realloc(view->order, (size_t)rows * sizeof(long)); // contents survive, so the UI keeps its order
+    if (!order) return false;
+    view->order = (long *)order;
+    void *back = rui_realloc(view->back, (size_t)rows * sizeof(long));
+    if (!back) return false;
+    view->back = (long *)back;
+    void *chunks = rui_realloc(view->chunks, (size_t)slices * sizeof(rui_sort_chunk));
+    if (!chunks) return false;
+    view->chunks = (rui_sort_chunk *)chunks;
+    view->capacity = rows;
+    return true;
+}
+
+static void rui_sort_view_start(rui_sort_view *view, const rui_sort_request *request) {
+    bool first = view->order == NULL;
+    if (!rui_sort_view_reserve(view, request->rowCount)) return; // out of memory: keep showing the current order
+    if (first) view->count = -1; // reserve allocated order before any result exists
+    view->active = *request;
+    view->busy = true;
+    view->ready = 0;
+    view->cancel = 0;
+    view->unitsDone = 0;
+    view->unitsTotal = 0;
+    view->deferred = !rui_task_try_submit(rui_sort_job, view, &rui_sortPending); // never sort inline on the UI thread
+}
+
+void rui_sort_view_request(rui_sort_view *view, const rui_sort_request *request) {
+    if (!view || !request || request->rowCount < 0) return;
+    if (view->busy) { // the running result is already stale: stop it and start the latest request when it ends
+        view->next = *request;
+        view->hasNext = true;
+        RUI_ATOMIC_STORE(&view->cancel, 1);
+        return;
+    }
+    rui_sort_view_start(view, request);
+}
+
+bool rui_sort_view_poll(rui_sort_view *view) {
+    if (!view || !view->busy) return false;
+    if (view->deferred) { // still waiting for room in the task queue
+        view->deferred = !rui_task_try_submit(rui_sort_job, view, &rui_sortPending);
+        return false;
+    }
+    int ready = RUI_ATOMIC_LOAD(&view->ready); // the coordinator's last write: nothing to wait for or help with
+    if (ready == 0) return false;
+    bool swapped = false;
+    if (ready == 1) { // the whole swap is two pointer writes on the UI thread
+        long *order = view->order;
+        view->order = view->back;
+        view->back = order;
+        view->count = view->backCount;
+        swapped = true;
+    }
+    view->busy = false;
+    if (view->hasNext) {
+        view->hasNext = false;
+        rui_sort_view_start(view, &view->next);
+    }
+    return swapped;
+}
+
+bool rui_sort_view_busy(const rui_sort_view *view) {
+    return view && (view->busy || view->hasNext);
+}
+
+float rui_sort_view_progress(const rui_sort_view *view) {
+    if (!view || !view->busy) return 1.0f;
+    int total = RUI_ATOMIC_LOAD((int *)&view->unitsTotal); // 0 while the coordinator is still queued
+    if (total <= 0) return 0.0f;
+    float progress = (float)RUI_ATOMIC_LOAD((int *)&view->unitsDone) / (float)total;
+    return progress < 0.99f ? progress : 0.99f; // 1 only once the index is swapped in
+}
+
+long rui_sort_view_count(const rui_sort_view *view, long rowCount) {
+    return (view && view->order && view->count >= 0) ? view->count : rowCount;
+}
+
+long rui_sort_view_row(const rui_sort_view *view, long index) {
+    return (view && view->order && view->count >= 0 && index >= 0 && index < view->count) ? view->order[index] : index;
+}
+
+void rui_sort_view_free(rui_sort_view *view) {
+    if (!view) return;
+    if (view->busy) {
+        RUI_ATOMIC_STORE(&view->cancel, 1);
+        if (!view->deferred) rui_task_wait_flag(&view->ready); // the cancelled job stops at its next slice
+    }
+    rui_free(view->items);
+    rui_free(view->scratch);
+    rui_free(view->order);
+    rui_free(view->back);
+    rui_free(view->chunks);
+    *view = (rui_sort_view){ 0 };
+}
+
+// --- Tree View ---
+// Visible rows live in a gap buffer whose gap follows the last expand/collapse, so repeated edits in one
+// area move only the rows between edits, and row lookup stays O(1) for drawing.
+static rui_tree_row *rui_tree_slot(const rui_tree *tree, long row) { // logical row -> physical slot
+    return &tree->rows[row < tree->gapStart ? row : row + (tree->capacity - tree->count)];
+}
+
+const rui_tree_row *rui_tree_row_at(const rui_tree *tree, long row) {
+    if (!tree || row < 0 || row >= tree->count) return NULL;
+    return rui_tree_slot(tree, row);
+}
+
+static void rui_tree_move_gap(rui_tree *tree, long position) {
+    long gap = tree->capacity - tree->count;
+    if (position < tree->gapStart) {
+        memmove(tree->rows + position + gap, tree->rows + position, (size_t)(tree->gapStart - position) * sizeof(rui_tree_row));
+    } else if (position > tree->gapStart) {
+        memmove(tree->rows + tree->gapStart, tree->rows + tree->gapStart + gap, (size_t)(position - tree->gapStart) * sizeof(rui_tree_row));
+    }
+    tree->gapStart = position;
+}
 
-        int ch = GetCharPressed();
-        while (ch > 0) { // process character input
-            int prevLen = input->length;
-            rui_text_input_insert_char(input, ch);
-            changed |= (prevLen != input->length);
-            ch = GetCharPressed();
-        }
+static bool rui_tree_reserve(rui_tree *tree, long extra) { // make the gap at least extra rows wide
+    if (tree->capacity - tree->count >= extra) return true;
+    long capacity = tree->capacity > 0 ? tree->capacity * 2 : 64;
+    while (capacity - tree->count < extra) capacity *= 2;
+    rui_tree_row *rows = (rui_tree_row *)rui_realloc(NULL, (size_t)capacity * sizeof(rui_tree_row));
+    if (!rows) return false;
+    long tail = tree->count - tree->gapStart;
+    if (tree->rows) {
+        memcpy(rows, tree->rows, (size_t)tree->gapStart * sizeof(rui_tree_row));
+        memcpy(rows + capacity - tail, tree->rows + tree->capacity - tail, (size_t)tail * sizeof(rui_tree_row));
+        rui_free(tree->rows);
+    }
+    tree->rows = rows;
+    tree->capacity = capacity;
+    return true;
+}
 
-        input->blinkTimer += GetFrameTime(); // advance caret blink
-        if (input->blinkTimer > 1.0f) input->blinkTimer -= 1.0f; // wrap timer
-    } else {
-        input->blinkTimer = 0.0f; // reset when not active
+static long rui_tree_insert_children(rui_tree *tree, long position, rui_tree_id parent, int depth) { // fetch and insert one level
+    if (!tree->children) return 0;
+    long count = tree->children(parent, NULL, 0, tree->userData);
+    if (count <= 0) return 0;
+    if (count > tree->scratchCapacity) {
+        void *scratch = rui_realloc(tree->scratch, (size_t)count * sizeof(rui_tree_id));
+        if (!scratch) return 0;
+        tree->scratch = (rui_tree_id *)scratch;
+        tree->scratchCapacity = count;
     }
+    count = tree->children(parent, tree->scratch, count, tree->userData);
+    if (count > tree->scratchCapacity) count = tree->scratchCapacity;
+    if (count <= 0 || !rui_tree_reserve(tree, count)) return 0;
+    rui_tree_move_gap(tree, position);
+    for (long i = 0; i < count; ++i) {
+        rui_tree_row *row = &tree->rows[position + i];
+        row->id = tree->scratch[i];
+        row->depth = depth;
+        row->hasChildren = tree->hasChildren ? tree->hasChildren(row->id, tree->userData) : true;
+        row->expanded = false;
+    }
+    tree->gapStart += count;
+    tree->count += count;
+    return count;
+}
 
-    const rui_text_input_style *tis = &rui_themeCurrent.textInput; // theme colours
-    Color borderColor = (rui_activeTextInput == input) ? tis->borderActive
-                        : (hovered ? tis->borderHover : tis->border); // highlight when focused
-    DrawRectangleRec(bounds, rui_apply_alpha(tis->background)); // draw background
-    DrawRectangleLinesEx(bounds, 2, rui_apply_alpha(borderColor)); // draw border
+bool rui_tree_init(rui_tree *tree, rui_tree_id root, rui_tree_children_fn children, rui_tree_has_children_fn hasChildren, rui_tree_label_fn label, void *userData) {
+    if (!tree) return false;
+    *tree = (rui_tree){ 0 };
+    tree->root = root;
+    tree->children = children;
+    tree->hasChildren = hasChildren;
+    tree->label = label;
+    tree->userData = userData;
+    tree->hoveredRow = -1;
+    rui_tree_insert_children(tree, 0, root, 0);
+    return true;
+}
 
-    float textHeight = (float)fs->size;
-    Vector2 textPos = { bounds.x + 4.0f, bounds.y + (bounds.height - textHeight) * 0.5f }; // baseline for text
-    DrawTextEx(fs->font,
-               input->buffer ? input->buffer : "",
-               textPos,
-               (float)fs->size,
-               fs->spacing,
-               rui_apply_alpha(tis->text)); // draw text contents
+void rui_tree_reload(rui_tree *tree) {
+    if (!tree) return;
+    tree->count = 0;
+    tree->gapStart = 0;
+    rui_tree_insert_children(tree, 0, tree->root, 0);
+}
 
-    if (rui_activeTextInput == input) { // draw caret when active
-        float caretX = textPos.x;
-        if (input->cursor > 0) {
-            char temp = input->buffer[input->cursor];
-            input->buffer[input->cursor] = '\0';
-            caretX += MeasureTextEx(fs->font, input->buffer, (float)fs->size, fs->spacing).x;
-            input->buffer[input->cursor] = temp;
-        }
+bool rui_tree_toggle(rui_tree *tree, long row) {
+    if (!tree || row < 0 || row >= tree->count) return false;
+    rui_tree_row *node = rui_tree_slot(tree, row);
+    if (node->expanded) { // drop the descendants that follow; they come back collapsed on the next expand
+        int depth = node->depth;
+        long end = row + 1;
+        while (end < tree->count && rui_tree_slot(tree, end)->depth > depth) end++;
+        rui_tree_move_gap(tree, row + 1);
+        tree->count -= end - (row + 1); // the gap swallows them
+        rui_tree_slot(tree, row)->expanded = false;
+        return true;
+    }
+    if (!node->hasChildren) return false;
+    rui_tree_id id = node->id;
+    int depth = node->depth;
+    long added = rui_tree_insert_children(tree, row + 1, id, depth + 1);
+    node = rui_tree_slot(tree, row); // the gap may have moved past it
+    node->expanded = added > 0;
+    if (added == 0) node->hasChildren = false; // nothing there after all: hide the expander
+    return added > 0;
+}
+
+void rui_tree_free(rui_tree *tree) {
+    if (!tree) return;
+    rui_free(tree->rows);
+    rui_free(tree->scratch);
+    *tree = (rui_tree){ 0 };
+}
 
-        if (fmodf(input->blinkTimer, 1.0f) < 0.5f) { // blink on for half the time
-            DrawRectangle((int)caretX, (int)textPos.y, 2, fs->size, rui_apply_alpha(tis->caret));
+long rui_panel_tree(rui_tree *tree) { // only rows inside the viewport are labelled and drawn
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit || !tree) return -1;
+
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    const rui_button_style *bs = &rui_ctx->skin->theme.button;
+    float inset = rui_ctx->skin->metrics.textInset;
+    float rowHeight = tree->rowHeight > 0.0f ? tree->rowHeight : (float)fs->size + 2.0f * inset;
+    float indent = (float)fs->size; // per depth level, also the expander width
+    float left = rui_layout->panelInnerLeft;
+    float width = rui_layout->panelInnerRight - rui_layout->panelInnerLeft;
+
+    double top = rui_layout->panelCursorY;
+    double height = (double)rowHeight * (double)tree->count;
+    rui_panel_advance(height + rui_layout->panelSpacing);
+
+    Rectangle viewport = { rui_layout->currentPanel.x, rui_layout->currentPanel.y + rui_layout->panelHeaderHeight,
+                           rui_layout->currentPanel.width, rui_layout->currentPanel.height - rui_layout->panelHeaderHeight };
+    float visibleTop = fmaxf(rui_panel_screen_y(top), viewport.y);
+    float visibleBottom = fminf(rui_panel_screen_y(top + height), viewport.y + viewport.height);
+    tree->hoveredRow = -1;
+    if (visibleBottom <= visibleTop || width <= 0.0f) return -1;
+
+    Rectangle visible = { left, visibleTop, width, visibleBottom - visibleTop };
+    long first = (long)fmax(0.0, floor((rui_layout->scrollOffset + (visibleTop - viewport.y) - top) / rowHeight));
+    long last = (long)fmin((double)tree->count, ceil((rui_layout->scrollOffset + (visibleBottom - viewport.y) - top) / rowHeight));
+    if (rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, visible))) {
+        double row = floor((rui_layout->scrollOffset + (rui_ctx->mouse.y - viewport.y) - top) / rowHeight);
+        if (row >= 0.0 && row < (double)tree->count) tree->hoveredRow = (long)row;
+    }
+
+    long clicked = -1;
+    if (tree->hoveredRow >= 0 && rui_ctx->mousePressed) {
+        const rui_tree_row *row = rui_tree_slot(tree, tree->hoveredRow);
+        float expanderX = left + (float)row->depth * indent;
+        if (row->hasChildren && rui_ctx->mouse.x >= expanderX && rui_ctx->mouse.x < expanderX + indent) {
+            rui_tree_toggle(tree, tree->hoveredRow); // rows below shift; they are laid out from the new list below
+            if (last > tree->count) last = tree->count;
+            rui_layout->panelCacheDirty = true;
+        } else {
+            clicked = tree->hoveredRow;
+            tree->selected = row->id;
+            tree->hasSelection = true;
         }
     }
 
-    return changed; // report whether text changed this frame
+    unsigned int hash = rui_hash_int((int)first, rui_hash_int((int)last, rui_hash_int((int)tree->hoveredRow, 0)));
+    Color textColor = rui_apply_alpha(rui_ctx->skin->theme.textInput.text);
+    char buffer[128]; // scratch for formatted labels
+    for (long i = first; i < last; ++i) {
+        const rui_tree_row *row = rui_tree_slot(tree, i);
+        float y = rui_panel_screen_y(top + (double)i * rowHeight);
+        Rectangle r = { left, y, width, rowHeight };
+        bool selected = tree->hasSelection && row->id == tree->selected;
+        Color normal = rui_apply_alpha(selected ? bs->pressed : rui_ctx->skin->theme.textInput.background);
+        int fill = rui_draw_rect(r, i == tree->hoveredRow ? rui_apply_alpha(bs->hover) : normal);
+        rui_draw_patch_add(fill, GetCollisionRec(r, visible), normal, rui_apply_alpha(bs->hover), NULL);
+
+        float x = left + (float)row->depth * indent;
+        float textY = y + (rowHeight - (float)fs->size) * 0.5f;
+        if (row->hasChildren) {
+            rui_draw_text(fs->font, row->expanded ? "-" : "+", (Vector2){ x + inset * 0.5f, textY }, (float)fs->size, fs->spacing, textColor);
+        }
+        buffer[0] = '\0';
+        const char *text = tree->label ? tree->label(row->id, buffer, (int)sizeof(buffer), tree->userData) : NULL;
+        if (text && text[0]) {
+            rui_draw_text(fs->font, text, (Vector2){ x + indent, textY }, (float)fs->size, fs->spacing, textColor);
+            hash = rui_hash_string(text, hash);
+        }
+        hash = rui_hash_int(row->depth | (row->expanded << 16) | (selected << 17), hash);
+    }
+    rui_damage_track(visible, hash);
+    return clicked;
 }
 
-bool rui_keyboard_captured(void) { // let callers know UI owns keyboard this frame
-    return rui_keyboardCaptured;
+// --- Combo Box ---
+// The popup is recorded into the context's popup list and drawn after the rest of the UI, so it is never
+// clipped by its panel and never advances the panel cursor. Next frame its rectangle hides the mouse from
+// the widgets underneath.
+void rui_draw_popups(void) {
+    rui_draw_list *list = rui_ctx->popups;
+    if (!list || list->commandCount == 0) return;
+    if (rui_layout->drawExecute) rui_draw_list_submit(list);
+    if (rui_layout->drawRecordTarget) rui_draw_list_append(rui_layout->drawRecordTarget, list);
+    rui_draw_list_reset(list);
 }
 
-static void rui_fade_start(unsigned char targetAlpha, float duration) { // internal helper to configure fade animation
-    rui_fadeStartAlpha = rui_fadeAlpha; // remember current alpha as starting point
-    rui_fadeTargetAlpha = (float)targetAlpha; // store goal alpha value
-    rui_fadeDuration = duration; // store duration in seconds
-    rui_fadeElapsed = 0.0f; // reset elapsed timer
-    if (duration <= 0.0f) { // if duration zero or negative, snap immediately
-        rui_fadeAlpha = rui_fadeTargetAlpha;
-        rui_fadeActive = false;
+typedef struct rui_popup_scope { // draw state replaced while a popup records
+    rui_draw_list *target;
+    bool execute;
+    bool capturing;
+} rui_popup_scope;
+
+static rui_popup_scope rui_popup_begin(Rectangle area) { // route draws into the popup list and claim area for next frame's input
+    rui_popup_scope scope = { rui_layout->drawRecordTarget, rui_layout->drawExecute, rui_layout->panelCacheCapturing };
+    if (rui_layout != &rui_ctx->layout) return scope; // panel jobs draw popups inline
+    if (!rui_ctx->popups && (rui_ctx->popups = (rui_draw_list *)rui_realloc(NULL, sizeof(rui_draw_list))) != NULL) *rui_ctx->popups = (rui_draw_list){0};
+    if (!rui_ctx->popups) return scope; // no memory: draw inline
+    rui_layout->drawRecordTarget = rui_ctx->popups;
+    rui_layout->drawExecute = false;
+    rui_layout->panelCacheCapturing = false; // popups stay out of cached panel textures
+
+    Rectangle *r = &rui_ctx->popupRect; // grow this frame's popup area
+    if (r->width <= 0.0f || r->height <= 0.0f) {
+        *r = area;
     } else {
-        rui_fadeActive = true; // mark fade as active
+        float left = fminf(r->x, area.x), top = fminf(r->y, area.y);
+        float right = fmaxf(r->x + r->width, area.x + area.width), bottom = fmaxf(r->y + r->height, area.y + area.height);
+        *r = (Rectangle){ left, top, right - left, bottom - top };
     }
+    return scope;
 }
 
-void rui_fade_set_color(Color color) { // choose color for fade overlay
-    rui_fadeColor = color; // store desired overlay tint (alpha controlled separately)
+static void rui_popup_end(rui_popup_scope scope) {
+    rui_layout->drawRecordTarget = scope.target;
+    rui_layout->drawExecute = scope.execute;
+    rui_layout->panelCacheCapturing = scope.capturing;
 }
 
-void rui_fade_out(float duration) { // start fade to fully opaque overlay
-    rui_fade_start(255, duration); // animate alpha to 255
+void rui_combo_init(rui_combo *combo, long itemCount, rui_item_fn item, void *userData) {
+    if (!combo) return;
+    *combo = (rui_combo){ 0 };
+    combo->selected = -1;
+    rui_combo_set_items(combo, itemCount, item, userData);
 }
 
-void rui_fade_in(float duration) { // start fade back to transparent
-    rui_fade_start(0, duration); // animate alpha to 0
+void rui_combo_free(rui_combo *combo) {
+    if (!combo) return;
+    rui_free(combo->index);
+    rui_free(combo->labels);
+    rui_free(combo->labelOffsets);
+    combo->index = NULL;
+    combo->labels = NULL;
+    combo->labelOffsets = NULL;
+    if (rui_ctx->activeCombo == combo) { // freed while open: nothing is left to release the keyboard
+        rui_ctx->activeCombo = NULL;
+        rui_ctx->keyboardCaptured = rui_ctx->activeTextInput != NULL;
+    }
+    combo->open = false;
 }
 
-bool rui_fade_active(void) { // expose whether fade animation running
-    return rui_fadeActive; // simply return state flag
+void rui_combo_set_items(rui_combo *combo, long itemCount, rui_item_fn item, void *userData) {
+    if (!combo) return;
+    rui_free(combo->index); // built once per item source
+    rui_free(combo->labels);
+    rui_free(combo->labelOffsets);
+    combo->index = NULL;
+    combo->labels = NULL;
+    combo->labelOffsets = NULL;
+    combo->itemCount = itemCount > 0 ? itemCount : 0;
+    combo->item = item;
+    combo->userData = userData;
+    if (combo->selected >= combo->itemCount) combo->selected = -1;
+    combo->highlighted = combo->selected >= 0 ? combo->selected : 0;
+    combo->typedLength = 0;
 }
 
-void rui_draw_fade(void) { // draw fade overlay if alpha greater than zero
-    if (rui_fadeAlpha <= 0.0f) return; // nothing to draw when alpha 0
-    Color overlay = rui_fadeColor; // copy base color
-    overlay.a = (unsigned char)Clamp(rui_fadeAlpha, 0.0f, 255.0f); // apply animated alpha
-    DrawRectangle(0, 0, GetRenderWidth(), GetRenderHeight(), overlay); // cover entire render surface
+static int rui_fold(int c) { // ASCII case folding for type-ahead
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
 }
 
-// --- Manual Panel ---
-void rui_panel(Rectangle bounds, const char *title) { // draw basic panel using default style
-    rui_panel_ex(bounds, title, rui_panelStyleDefault); // forward to full implementation with default style
+static int rui_compare_folded(const char *a, const char *b, int limit) { // limit < 0 compares whole strings
+    for (int i = 0; limit < 0 || i < limit; ++i) {
+        int x = rui_fold((unsigned char)a[i]), y = rui_fold((unsigned char)b[i]);
+        if (x != y || x == 0) return x - y;
+    }
+    return 0;
 }
 
-void rui_panel_ex(Rectangle bounds, const char *title, rui_panel_style style) { // draw a static panel shell with style
-    if (!rui_themeInitialized) {
-        rui_theme_reset();
-    }
+static RUI_THREAD_LOCAL const rui_combo *rui_comboSorting; // qsort has no context argument
 
-    DrawRectangleRec(bounds, rui_apply_alpha(style.bodyColor)); // paint panel background with styled color
-    DrawRectangleLinesEx(bounds, 2, rui_apply_alpha(style.borderColor)); // outline panel borders using styled color
+static int rui_combo_index_compare(const void *x, const void *y) {
+    long a = *(const long *)x, b = *(const long *)y;
+    int c = rui_compare_folded(rui_comboSorting->labels + rui_comboSorting->labelOffsets[a],
+                               rui_comboSorting->labels + rui_comboSorting->labelOffsets[b], -1);
+    return c != 0 ? c : (a < b ? -1 : 1);
+}
 
-    if (title) { // draw optional title bar when provided
-        float headerHeight = rui_calculate_header_height(true);
-        Rectangle titleBar = { bounds.x, bounds.y, bounds.width, headerHeight };
-        DrawRectangleRec(titleBar, rui_apply_alpha(style.titleColor));
-        DrawRectangleLinesEx(titleBar, 1, rui_apply_alpha(style.borderColor));
+static bool rui_combo_build_index(rui_combo *combo) { // one pass over the source, then one sort
+    if (combo->index) return true;
+    long count = combo->itemCount;
+    long *offsets = (long *)rui_realloc(NULL, (size_t)(count > 0 ? count : 1) * sizeof(long));
+    long *index = (long *)rui_realloc(NULL, (size_t)(count > 0 ? count : 1) * sizeof(long));
+    char *labels = NULL;
+    long size = 0, capacity = 0;
+    bool ok = offsets && index;
+    char buffer[128];
+    for (long i = 0; ok && i < count; ++i) {
+        buffer[0] = '\0';
+        const char *text = combo->item ? combo->item(i, buffer, (int)sizeof(buffer), combo->userData) : NULL;
+        if (!text) text = "";
+        long length = (long)strlen(text) + 1;
+        if (size + length > capacity) {
+            long grown = capacity > 0 ? capacity * 2 : 4096;
+            while (grown < size + length) grown *= 2;
+            char *resized = (char *)rui_realloc(labels, (size_t)grown);
+            if (!resized) { ok = false; break; }
+            labels = resized;
+            capacity = grown;
+        }
+        memcpy(labels + size, text, (size_t)length);
+        offsets[i] = size;
+        index[i] = i;
+        size += length;
+    }
+    if (!ok) {
+        rui_free(offsets);
+        rui_free(index);
+        rui_free(labels);
+        return false;
+    }
+    combo->labels = labels;
+    combo->labelOffsets = offsets;
+    rui_comboSorting = combo;
+    qsort(index, (size_t)count, sizeof(long), rui_combo_index_compare);
+    combo->index = index;
+    return true;
+}
 
-        const rui_font_style *tf = &rui_themeCurrent.titleFont;
-        float paddingY = (headerHeight - (float)tf->size) * 0.5f;
-        if (paddingY < 0.0f) paddingY = 0.0f;
-        DrawTextEx(tf->font,
-                   title,
-                   (Vector2){ bounds.x + 6.0f, bounds.y + paddingY },
-                   (float)tf->size,
-                   tf->spacing,
-                   rui_apply_alpha(style.titleTextColor));
+static long rui_combo_lower_bound(const rui_combo *combo, const char *prefix, int length) { // first index position >= prefix
+    long lo = 0, hi = combo->itemCount;
+    while (lo < hi) {
+        long mid = lo + (hi - lo) / 2;
+        if (rui_compare_folded(combo->labels + combo->labelOffsets[combo->index[mid]], prefix, length) < 0) lo = mid + 1;
+        else hi = mid;
     }
+    return lo;
 }
 
-// --- Auto-layout + Scrollable Panels ---
-static void rui_panel_begin_internal(Rectangle bounds, const char *title, bool scrollable, rui_panel_style style, float alpha) {
-    if (!rui_themeInitialized) {
-        rui_theme_reset();
+static void rui_combo_type(rui_combo *combo, int ch) { // jump to the first item starting with the typed prefix
+    if (ch < 32 || ch > 126 || !rui_combo_build_index(combo)) return; // index covers single-byte text
+    double now = GetTime();
+    if (now - combo->typedTime > RUI_TYPEAHEAD_TIMEOUT) combo->typedLength = 0;
+    combo->typedTime = now;
+    bool repeat = combo->typedLength == 1 && rui_fold(combo->typed[0]) == rui_fold(ch); // same letter again cycles its matches
+    if (!repeat && combo->typedLength < (int)sizeof(combo->typed) - 1) combo->typed[combo->typedLength++] = (char)ch;
+    combo->typed[combo->typedLength] = '\0';
+
+    long position = rui_combo_lower_bound(combo, combo->typed, combo->typedLength);
+    if (repeat) {
+        long next = combo->typedPosition + 1;
+        if (next < combo->itemCount && rui_compare_folded(combo->labels + combo->labelOffsets[combo->index[next]], combo->typed, combo->typedLength) == 0) {
+            position = next;
+        }
     }
+    if (position >= combo->itemCount ||
+        rui_compare_folded(combo->labels + combo->labelOffsets[combo->index[position]], combo->typed, combo->typedLength) != 0) return; // no match: stay put
+    combo->typedPosition = position;
+    combo->highlighted = combo->index[position];
+}
 
-    rui_panelAlphaApplied = false;
-    float clampedAlpha = rui_clamp01(alpha);
-    if (clampedAlpha != 1.0f) {
-        rui_push_alpha(clampedAlpha);
-        rui_panelAlphaApplied = true;
+static void rui_combo_close(rui_combo *combo) {
+    combo->open = false;
+    if (rui_ctx->activeCombo == combo) {
+        rui_ctx->activeCombo = NULL;
+        rui_ctx->keyboardCaptured = rui_ctx->activeTextInput != NULL;
     }
+}
 
-    rui_currentPanel = bounds; // remember panel rectangle for children
-    rui_panelHasTitle = (title != NULL); // store whether title bar exists
-    rui_panelHeaderHeight = rui_calculate_header_height(rui_panelHasTitle);
-    rui_panelCursorY = bounds.y + rui_panelHeaderHeight + rui_panelPadding; // initialize layout cursor beneath header
-    rui_contentHeight = 0; // reset content height for this frame
-    rui_panelActive = true; // mark panel as active for child widgets
-    rui_panelScrollable = scrollable; // store whether scrolling is enabled
-    rui_currentPanelStyle = style; // store style for child widgets rendered this frame
-    rui_scrollOffsetBeforePanel = rui_scrollOffset; // remember incoming scroll offset so it can be restored for other panels
+bool rui_combo_box(rui_combo *combo, Rectangle bounds) {
+    if (!combo) return false;
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    const rui_button_style *bs = &rui_ctx->skin->theme.button;
+    const rui_text_input_style *tis = &rui_ctx->skin->theme.textInput;
+    float inset = rui_ctx->skin->metrics.textInset;
+    bool mainThread = rui_layout == &rui_ctx->layout; // panel jobs can't take focus or use the popup list
+    bool inPanel = rui_layout->panelActive && !rui_layout->panelCacheHit;
+    Rectangle viewport = { rui_layout->currentPanel.x, rui_layout->currentPanel.y + rui_layout->panelHeaderHeight,
+                           rui_layout->currentPanel.width, rui_layout->currentPanel.height - rui_layout->panelHeaderHeight };
+    bool changed = false;
 
-    float scrollbarWidth = scrollable ? 12.0f : 0.0f; // reserve space for scrollbar when needed
-    rui_panelInnerLeft = rui_currentPanel.x + rui_panelPadding; // compute inner left boundary
-    rui_panelInnerRight = rui_currentPanel.x + rui_currentPanel.width - rui_panelPadding - scrollbarWidth; // inner right boundary after padding and scrollbar
-    if (rui_panelInnerRight < rui_panelInnerLeft) { // guard against inverted bounds
-        rui_panelInnerRight = rui_panelInnerLeft; // collapse to avoid negative widths
+    bool hovered = rui_note_hover(CheckCollisionPointRec(rui_ctx->mouse, bounds));
+    if (hovered && rui_ctx->mousePressed && mainThread) {
+        if (combo->open) {
+            rui_combo_close(combo);
+        } else {
+            if (rui_ctx->activeCombo && rui_ctx->activeCombo != combo) rui_ctx->activeCombo->open = false;
+            rui_text_input_set_active(NULL);
+            combo->open = true;
+            combo->highlighted = combo->selected >= 0 ? combo->selected : 0;
+            combo->typedLength = 0;
+            rui_ctx->activeCombo = combo;
+            rui_ctx->keyboardCaptured = true; // arrows, enter and type-ahead belong to the popup
+        }
+        rui_layout->activity = true;
+    }
+    if (combo->open && rui_ctx->activeCombo != combo) combo->open = false; // another combo took focus, or it went undrawn for a frame
+    if (rui_ctx->activeCombo == combo && mainThread) rui_ctx->activeComboDrawn = true;
+
+    // Closed box: selected item and an arrow
+    Color fill = hovered ? bs->hover : bs->normal;
+    int box = rui_draw_rect(bounds, rui_apply_alpha(fill));
+    rui_draw_patch_add(box, bounds, rui_apply_alpha(bs->normal), rui_apply_alpha(bs->hover), NULL);
+    rui_draw_rect_lines(bounds, rui_ctx->skin->metrics.border, rui_apply_alpha(combo->open ? tis->borderActive : bs->border));
+    char buffer[128];
+    buffer[0] = '\0';
+    const char *current = (combo->selected >= 0 && combo->item) ? combo->item(combo->selected, buffer, (int)sizeof(buffer), combo->userData) : "";
+    if (!current) current = "";
+    float textY = bounds.y + (bounds.height - (float)fs->size) * 0.5f;
+    Vector2 arrowSize = MeasureTextEx(fs->font, "v", (float)fs->size, fs->spacing);
+    rui_draw_scissor_begin((Rectangle){ bounds.x, bounds.y, fmaxf(bounds.width - arrowSize.x - 2.0f * inset, 0.0f), bounds.height });
+    rui_draw_text(fs->font, current, (Vector2){ bounds.x + inset, textY }, (float)fs->size, fs->spacing, rui_apply_alpha(bs->text));
+    if (inPanel) rui_draw_scissor_begin(viewport); // scissors do not nest: restore the panel's clip
+    else rui_draw_scissor_end();
+    rui_draw_text(fs->font, combo->open ? "^" : "v", (Vector2){ bounds.x + bounds.width - inset - arrowSize.x, textY }, (float)fs->size, fs->spacing, rui_apply_alpha(bs->text));
+    unsigned int hash = rui_hash_string(current, rui_hash_int(hovered | (combo->open << 1), 0));
+    rui_damage_track(bounds, hash);
+    if (!combo->open) return false;
+
+    // Keyboard: arrows, page keys, enter/escape and type-ahead
+    rui_layout->panelCacheDirty = true;
+    int rows = combo->visibleRows > 0 ? combo->visibleRows : 8;
+    if (rows > combo->itemCount) rows = (int)combo->itemCount;
+    float rowHeight = (float)fs->size + 2.0f * inset;
+    if (mainThread) {
+        for (int key = GetKeyPressed(); key > 0; key = GetKeyPressed()) {
+            rui_layout->activity = true;
+            if (key == KEY_DOWN) combo->highlighted++;
+            else if (key == KEY_UP) combo->highlighted--;
+            else if (key == KEY_PAGE_DOWN) combo->highlighted += rows;
+            else if (key == KEY_PAGE_UP) combo->highlighted -= rows;
+            else if (key == KEY_HOME) combo->highlighted = 0;
+            else if (key == KEY_END) combo->highlighted = combo->itemCount - 1;
+            else if (key == KEY_ENTER || key == KEY_KP_ENTER) {
+                changed = combo->highlighted != combo->selected && combo->itemCount > 0;
+                if (combo->itemCount > 0) combo->selected = combo->highlighted;
+                rui_combo_close(combo);
+                return changed;
+            } else if (key == KEY_ESCAPE) {
+                rui_combo_close(combo);
+                return false;
+            } else {
+                continue;
+            }
+            if (combo->highlighted >= combo->itemCount) combo->highlighted = combo->itemCount - 1;
+            if (combo->highlighted < 0) combo->highlighted = 0;
+            double y = (double)combo->highlighted * rowHeight; // keep the keyboard row in view
+            if (y < combo->scroll) combo->scroll = y;
+            if (y + rowHeight > combo->scroll + rows * rowHeight) combo->scroll = y + rowHeight - rows * rowHeight;
+        }
+        for (int ch = GetCharPressed(); ch > 0; ch = GetCharPressed()) {
+            rui_combo_type(combo, ch);
+            double y = (double)combo->highlighted * rowHeight;
+            if (y < combo->scroll || y + rowHeight > combo->scroll + rows * rowHeight) combo->scroll = y; // type-ahead jumps put the match on top
+            rui_layout->activity = true;
+        }
     }
-    rui_panelContentWidth = rui_panelInnerRight - rui_panelInnerLeft; // default content width spans full interior
 
-    float viewHeight = bounds.height - rui_panelHeaderHeight; // compute visible height excluding header
-    if (scrollable) { // only read scroll input for scrollable panels
-        float wheel = GetMouseWheelMove(); // get wheel delta for this frame
-        if (CheckCollisionPointRec(rui_mouse, bounds)) { // ensure cursor is over panel
-            rui_scrollOffset += wheel * 20;   // overshoot allowed to keep wheel responsive
+    // Popup under the box (above it when it would leave the screen)
+    Rectangle popup = { bounds.x, bounds.y + bounds.height, bounds.width, rows * rowHeight };
+    if (popup.y + popup.height > (float)GetScreenHeight() && bounds.y - popup.height >= 0.0f) popup.y = bounds.y - popup.height;
+    double maxScroll = fmax((double)combo->itemCount * rowHeight - popup.height, 0.0);
+    bool popupHovered = CheckCollisionPointRec(rui_ctx->popupMouse, popup);
+    if (popupHovered) combo->scroll += GetMouseWheelMove() * rui_ctx->skin->metrics.scrollStep * 3.0f; // same direction as panels
+    combo->scroll = rui_clamp_offset(combo->scroll, maxScroll);
+
+    long hoveredItem = -1;
+    if (popupHovered) {
+        double item = floor((combo->scroll + (rui_ctx->popupMouse.y - popup.y)) / rowHeight);
+        if (item >= 0.0 && item < (double)combo->itemCount) hoveredItem = (long)item;
+    }
+    if (rui_ctx->popupPressed && mainThread) {
+        if (hoveredItem >= 0) {
+            changed = hoveredItem != combo->selected;
+            combo->selected = hoveredItem;
+            rui_combo_close(combo);
+            rui_layout->activity = true;
+            return changed;
         }
+        if (!popupHovered && !hovered) { // clicked elsewhere
+            rui_combo_close(combo);
+            rui_layout->activity = true;
+            return false;
+        }
+    }
 
-        float maxOffset = rui_prevContentHeight - viewHeight; // maximum scroll based on previous content
-        if (maxOffset > 0) { // clamp only when content exceeds view
-            rui_scrollOffset = Clamp(rui_scrollOffset, 0, maxOffset); // keep scroll offset within bounds
-        } else if (rui_hasPrevContent) { // if previous content was smaller, reset offset
-            rui_scrollOffset = 0; // snap back to top when nothing to scroll
+    // Draw the visible rows into the popup list
+    rui_popup_scope scope = rui_popup_begin(popup);
+    rui_draw_scissor_begin(popup);
+    rui_draw_rect(popup, rui_apply_alpha(tis->background));
+    long first = (long)floor(combo->scroll / rowHeight);
+    long last = (long)fmin((double)combo->itemCount, ceil((combo->scroll + popup.height) / rowHeight));
+    for (long i = first; i < last; ++i) {
+        Rectangle r = { popup.x, popup.y + (float)((double)i * rowHeight - combo->scroll), popup.width, rowHeight };
+        Color normal = rui_apply_alpha(i == combo->selected ? bs->pressed : tis->background);
+        Color hover = rui_apply_alpha(bs->hover);
+        if (i == combo->highlighted) normal = hover;
+        int row = rui_draw_rect(r, i == hoveredItem ? hover : normal);
+        rui_draw_patch_add(row, GetCollisionRec(r, popup), normal, hover, NULL);
+        buffer[0] = '\0';
+        const char *text = combo->item ? combo->item(i, buffer, (int)sizeof(buffer), combo->userData) : NULL;
+        if (text && text[0]) {
+            rui_draw_text(fs->font, text, (Vector2){ r.x + inset, r.y + inset }, (float)fs->size, fs->spacing, rui_apply_alpha(tis->text));
+            hash = rui_hash_string(text, hash);
         }
-    } else { // non-scrollable panels temporarily reset offset during their draw
-        rui_scrollOffset = 0; // use zero offset for content placement
     }
+    rui_draw_scissor_end();
+    rui_draw_rect_lines(popup, rui_ctx->skin->metrics.border, rui_apply_alpha(tis->borderActive));
+    if (!mainThread && inPanel) rui_draw_scissor_begin(viewport); // drawn inline, so the panel's clip needs restoring
+    rui_popup_end(scope);
+    rui_damage_track(popup, rui_hash_int((int)first, rui_hash_int((int)combo->highlighted, rui_hash_int((int)hoveredItem, hash))));
+    return changed;
+}
 
-    rui_panel_ex(bounds, title, style); // draw panel chrome before clipping contents
+bool rui_panel_combo(rui_combo *combo, float height) {
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit) return false;
 
-    if (rui_panelCloseRequested && rui_panelHasTitle) { // optionally draw close button on title bar
-        float buttonSize = 18.0f;
-        Rectangle closeBounds = {
-            bounds.x + bounds.width - buttonSize - 6.0f,
-            bounds.y + (rui_panelHeaderHeight - buttonSize) * 0.5f,
-            buttonSize,
-            buttonSize
-        };
-        rui_panelClosePressed = rui_draw_close_button(closeBounds, rui_panelCloseLabel, style.borderColor);
-    } else {
-        rui_panelClosePressed = false;
+    float innerWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft; // usable width
+    float targetWidth = rui_layout->panelContentWidth; // requested width
+    if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp width
+
+    float x = rui_layout->panelInnerLeft; // base x coordinate
+    if (targetWidth < innerWidth) {
+        if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
+            x = rui_layout->panelInnerLeft + (innerWidth - targetWidth) * 0.5f;
+        } else if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
+            x = rui_layout->panelInnerRight - targetWidth;
+        }
     }
-    rui_panelCloseRequested = false; // clear request flag
-    rui_panelCloseLabel = NULL; // reset custom label
 
-    BeginScissorMode((int)bounds.x,
-                     (int)(bounds.y + rui_panelHeaderHeight),
-                     (int)bounds.width,
-                     (int)(bounds.height - rui_panelHeaderHeight)); // clip subsequent draws to panel interior
+    Rectangle bounds = { x, rui_panel_place_y(), targetWidth, height }; // only the closed box takes layout space
+    rui_panel_advance(height + rui_layout->panelSpacing); // advance cursor past the box
+    return rui_combo_box(combo, bounds);
 }
 
-void rui_panel_begin(Rectangle bounds, const char *title, bool scrollable) { // start a managed panel with default style
-    rui_panel_begin_internal(bounds, title, scrollable, rui_panelStyleDefault, 1.0f);
+// --- Command Palette ---
+// Every item's folded text is copied once into one buffer together with a 64-bit mask of the characters it
+// contains. A query first rejects items whose mask lacks one of its characters, then finds the subsequence
+// with memchr (vectorized by the C library) and scores the tightest window. When the query only grows, the
+// previous matches are the only ones that can still match, so only they are rescored.
+static int rui_palette_bit(int c) { // folded character -> mask bit
+    if (c >= 'a' && c <= 'z') return c - 'a';
+    if (c >= '0' && c <= '9') return 26 + (c - '0');
+    return 36 + (c & 0xFF) % 28;
 }
 
-void rui_panel_begin_ex(Rectangle bounds, const char *title, bool scrollable, rui_panel_style style) { // start panel with custom style
-    rui_panel_begin_internal(bounds, title, scrollable, style, 1.0f);
+void rui_palette_init(rui_palette *palette, long itemCount, rui_item_fn item, void *userData) {
+    if (!palette) return;
+    *palette = (rui_palette){ 0 };
+    palette->input = rui_text_input_init(palette->query, (int)sizeof(palette->query));
+    palette->chosen = -1;
+    rui_palette_set_items(palette, itemCount, item, userData);
 }
 
-void rui_panel_begin_fade(Rectangle bounds, const char *title, bool scrollable, float alpha) { // start default panel with fade alpha
-    rui_panel_begin_internal(bounds, title, scrollable, rui_panelStyleDefault, alpha);
+void rui_palette_free(rui_palette *palette) {
+    if (!palette) return;
+    rui_free(palette->candidates);
+    rui_free(palette->scores);
+    rui_free(palette->results);
+    rui_free(palette->labels);
+    rui_free(palette->labelOffsets);
+    rui_free(palette->masks);
+    palette->candidates = NULL;
+    palette->scores = NULL;
+    palette->results = NULL;
+    palette->labels = NULL;
+    palette->labelOffsets = NULL;
+    palette->masks = NULL;
+    palette->resultCount = 0;
+    palette->matchedValid = false;
 }
 
-void rui_panel_begin_ex_fade(Rectangle bounds, const char *title, bool scrollable, rui_panel_style style, float alpha) { // start styled panel with fade alpha
-    rui_panel_begin_internal(bounds, title, scrollable, style, alpha);
+void rui_palette_set_items(rui_palette *palette, long itemCount, rui_item_fn item, void *userData) {
+    if (!palette) return;
+    rui_palette_free(palette); // index belongs to the old source
+    palette->itemCount = itemCount > 0 ? itemCount : 0;
+    palette->item = item;
+    palette->userData = userData;
+    palette->highlighted = 0;
+    palette->scroll = 0.0;
 }
 
-bool rui_panel_button(const char *text, float height) { // add button within active panel
-    if (!rui_panelActive) return false; // guard when called outside panel pair
-
-    float innerWidth = rui_panelInnerRight - rui_panelInnerLeft; // effective interior width
-    float targetWidth = rui_panelContentWidth; // requested width for widgets
-    if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp width to interior
-
-    float x = rui_panelInnerLeft; // default to left alignment
-    if (targetWidth < innerWidth) { // adjust based on alignment when there is spare space
-        if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
-            x = rui_panelInnerLeft + (innerWidth - targetWidth) * 0.5f; // center within interior
-        } else if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
-            x = rui_panelInnerRight - targetWidth; // stick to right edge
+static bool rui_palette_build_index(rui_palette *palette) { // fold every label once per item source
+    if (palette->labels) return true;
+    long count = palette->itemCount;
+    size_t slots = (size_t)(count > 0 ? count : 1);
+    palette->labelOffsets = (long *)rui_realloc(NULL, (slots + 1) * sizeof(long));
+    palette->masks = (unsigned long long *)rui_realloc(NULL, slots * sizeof(unsigned long long));
+    palette->candidates = (long *)rui_realloc(NULL, slots * sizeof(long));
+    palette->scores = (int *)rui_realloc(NULL, slots * sizeof(int));
+    palette->results = (long *)rui_realloc(NULL, slots * sizeof(long));
+    bool ok = palette->labelOffsets && palette->masks && palette->candidates && palette->scores && palette->results;
+    char *labels = NULL;
+    long size = 0, capacity = 0;
+    char buffer[256];
+    for (long i = 0; ok && i < count; ++i) {
+        buffer[0] = '\0';
+        const char *text = palette->item ? palette->item(i, buffer, (int)sizeof(buffer), palette->userData) : NULL;
+        if (!text) text = "";
+        long length = (long)strlen(text) + 1;
+        if (size + length > capacity) {
+            long grown = capacity > 0 ? capacity * 2 : 65536;
+            while (grown < size + length) grown *= 2;
+            char *resized = (char *)rui_realloc(labels, (size_t)grown);
+            if (!resized) { ok = false; break; }
+            labels = resized;
+            capacity = grown;
         }
+        unsigned long long mask = 0;
+        for (long c = 0; c < length; ++c) {
+            int folded = rui_fold((unsigned char)text[c]);
+            labels[size + c] = (char)folded;
+            if (folded) mask |= 1ull << rui_palette_bit(folded);
+        }
+        palette->labelOffsets[i] = size;
+        palette->masks[i] = mask;
+        size += length;
     }
-
-    Rectangle r = { // compute button rectangle inside panel
-        x, // horizontal placement based on alignment
-        rui_panelCursorY - rui_scrollOffset, // subtract scroll to position correctly
-        targetWidth, // width respects alignment settings
-        height // use provided height for button box
-    };
-
-    rui_panelCursorY += height + rui_panelSpacing; // advance layout cursor for next widget
-    rui_contentHeight = rui_panelCursorY - (rui_currentPanel.y + rui_panelHeaderHeight); // update content height with header baseline
-
-    return rui_button(text, r); // draw button and return click state
-}
-
-bool rui_panel_button_call(const char *text, float height, void (*callback)(void *), void *userData) { // panel-aware button that fires callback
-    bool pressed = rui_panel_button(text, height); // draw button via layout helper
-    if (pressed && callback) { // fire callback when pressed
-        callback(userData); // forward user data pointer to callback
+    if (!ok) {
+        rui_free(labels);
+        rui_palette_free(palette);
+        return false;
     }
-    return pressed; // surface pressed status to caller
+    palette->labelOffsets[count] = size;
+    palette->labels = labels ? labels : (char *)rui_realloc(NULL, 1);
+    if (!palette->labels) {
+        rui_palette_free(palette);
+        return false;
+    }
+    if (!labels) palette->labels[0] = '\0';
+    return true;
 }
 
-void rui_panel_label(const char *text) { // add label within active panel using style color
-    rui_panel_label_color(text, rui_currentPanelStyle.labelColor); // defer to color-aware helper with style default
+static bool rui_palette_word_start(const char *label, long at) { // match right after a separator scores higher
+    if (at == 0) return true;
+    unsigned char before = (unsigned char)label[at - 1];
+    return !((before >= 'a' && before <= 'z') || (before >= '0' && before <= '9'));
 }
 
-void rui_panel_label_color(const char *text, Color color) { // add label within active panel using explicit color
-    if (!rui_panelActive) return; // ignore calls when no panel is active
+static int rui_palette_score(const char *label, long length, const char *query, int queryLength) { // 0 = no match
+    const char *end = label + length;
+    const char *at = label;
+    for (int q = 0; q < queryLength; ++q) { // leftmost subsequence: its last character ends the earliest window
+        at = (const char *)memchr(at, query[q], (size_t)(end - at));
+        if (!at) return 0;
+        at++;
+    }
+    long last = (long)(at - label) - 1;
+    long start = last;
+    for (int q = queryLength - 1; q >= 0; --q) { // walk back to the latest start of that window
+        while (label[start] != query[q]) start--;
+        if (q > 0) start--;
+    }
 
-    float innerWidth = rui_panelInnerRight - rui_panelInnerLeft; // width available inside panel
-    float targetWidth = rui_panelContentWidth; // requested content width
-    if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp to interior
+    int score = 0;
+    long previous = -2;
+    long position = start;
+    for (int q = 0; q < queryLength; ++q, ++position) {
+        while (label[position] != query[q]) position++;
+        score += 16;
+        if (position == previous + 1) score += 12; // consecutive run
+        else if (previous >= 0) score -= (int)fmin((double)(position - previous - 1), 8.0); // gap inside the window
+        if (rui_palette_word_start(label, position)) score += 10;
+        previous = position;
+    }
+    score -= (int)(start / 4) + (int)(length / 32); // earlier and shorter labels win ties
+    if (score < 1) score = 1;
+    if (score >= RUI_PALETTE_SCORE_LEVELS) score = RUI_PALETTE_SCORE_LEVELS - 1;
+    return score;
+}
 
-    float containerX = rui_panelInnerLeft; // default placement starts at inner left
-    if (targetWidth < innerWidth) { // adjust container placement when width narrower than available
-        if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
-            containerX = rui_panelInnerLeft + (innerWidth - targetWidth) * 0.5f; // center container
-        } else if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
-            containerX = rui_panelInnerRight - targetWidth; // anchor to right
+static void rui_palette_match(rui_palette *palette) { // bring results up to date with the query
+    char folded[sizeof(palette->query)];
+    int queryLength = 0;
+    unsigned long long queryMask = 0;
+    for (const char *c = palette->query; *c; ++c) {
+        if (*c == ' ') continue; // spaces only separate words for the reader
+        folded[queryLength++] = (char)rui_fold((unsigned char)*c);
+        queryMask |= 1ull << rui_palette_bit(folded[queryLength - 1]);
+    }
+    folded[queryLength] = '\0';
+    if (palette->matchedValid && strcmp(folded, palette->matched) == 0) return;
+    if (!rui_palette_build_index(palette)) return;
+
+    long *candidates = palette->candidates;
+    int *scores = palette->scores;
+    int matchedLength = (int)strlen(palette->matched);
+    bool narrowing = palette->matchedValid && matchedLength <= queryLength && strncmp(folded, palette->matched, (size_t)matchedLength) == 0;
+    long sourceCount = narrowing ? palette->resultCount : palette->itemCount;
+    long count = 0;
+    for (long n = 0; n < sourceCount; ++n) { // candidates stay in item order, so ties rank the same either way
+        long i = narrowing ? candidates[n] : n;
+        if (queryLength == 0) {
+            candidates[count] = i;
+            scores[count++] = 1;
+            continue;
         }
+        if ((palette->masks[i] & queryMask) != queryMask) continue;
+        long offset = palette->labelOffsets[i];
+        int score = rui_palette_score(palette->labels + offset, palette->labelOffsets[i + 1] - offset - 1, folded, queryLength);
+        if (score == 0) continue;
+        candidates[count] = i;
+        scores[count++] = score;
     }
 
-    const rui_font_style *fs = &rui_themeCurrent.textFont;
-    Vector2 textSize = MeasureTextEx(fs->font, text, (float)fs->size, fs->spacing);
-    float textX = containerX; // default left alignment
-    if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
-        float offset = (targetWidth - textSize.x) * 0.5f; // center text inside container
-        if (offset < 0.0f) offset = 0.0f; // prevent negative offset when text wider than container
-        textX = containerX + offset; // apply centering offset
-    } else if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
-        float offset = targetWidth - textSize.x; // align text against right edge
-        if (offset < 0.0f) offset = 0.0f; // clamp when text wider than container
-        textX = containerX + offset; // place text near right boundary
+    long buckets[RUI_PALETTE_SCORE_LEVELS] = { 0 }; // counting sort: linear in the match count, stable in item order
+    for (long n = 0; n < count; ++n) buckets[scores[n]]++;
+    long position = 0;
+    for (int level = RUI_PALETTE_SCORE_LEVELS - 1; level >= 0; --level) {
+        long size = buckets[level];
+        buckets[level] = position;
+        position += size;
     }
+    for (long n = 0; n < count; ++n) palette->results[buckets[scores[n]]++] = candidates[n];
 
-    DrawTextEx(fs->font,
-               text,
-               (Vector2){ textX, rui_panelCursorY - rui_scrollOffset },
-               (float)fs->size,
-               fs->spacing,
-               color);
+    palette->resultCount = count;
+    memcpy(palette->matched, folded, (size_t)queryLength + 1);
+    palette->matchedValid = true;
+    palette->highlighted = 0;
+    palette->scroll = 0.0;
+}
 
-    rui_panelCursorY += textSize.y + rui_panelSpacing; // move layout cursor past label height
-    rui_contentHeight = rui_panelCursorY - (rui_currentPanel.y + rui_panelHeaderHeight); // refresh content height after label
+void rui_palette_open(rui_palette *palette) {
+    if (!palette) return;
+    if (rui_ctx->activeCombo) rui_combo_close(rui_ctx->activeCombo);
+    palette->query[0] = '\0';
+    palette->input = rui_text_input_init(palette->query, (int)sizeof(palette->query));
+    palette->open = true;
+    palette->chosen = -1;
+    rui_text_input_set_active(&palette->input);
+    rui_palette_match(palette); // builds the index on first use
+    rui_layout->activity = true;
 }
 
-void rui_panel_spacer(float height) { // insert vertical space inside active panel
-    if (!rui_panelActive) return; // only operate inside a panel
-    rui_panelCursorY += height; // advance layout cursor by requested gap
-    rui_contentHeight = rui_panelCursorY - (rui_currentPanel.y + rui_panelHeaderHeight); // update content height after spacer
+void rui_palette_close(rui_palette *palette) {
+    if (!palette || !palette->open) return;
+    palette->open = false;
+    if (rui_ctx->activeTextInput == &palette->input) rui_text_input_set_active(NULL);
+    rui_layout->activity = true;
 }
 
-void rui_panel_set_content_width(float width) { // override width used for subsequent widgets
-    if (width <= 0.0f) { // zero or negative restores full interior width
-        rui_panelContentWidth = rui_panelInnerRight - rui_panelInnerLeft; // reset to full width
-    } else {
-        float maxWidth = rui_panelInnerRight - rui_panelInnerLeft; // maximum allowed width inside panel
-        if (width > maxWidth) width = maxWidth; // clamp to interior width
-        rui_panelContentWidth = width; // store new target width
+bool rui_command_palette(rui_palette *palette) {
+    if (!palette || !palette->open || rui_layout != &rui_ctx->layout) return false; // modal: main thread only
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    const rui_button_style *bs = &rui_ctx->skin->theme.button;
+    const rui_text_input_style *tis = &rui_ctx->skin->theme.textInput;
+    float inset = rui_ctx->skin->metrics.textInset, padding = rui_ctx->skin->metrics.padding;
+    float rowHeight = (float)fs->size + 2.0f * inset;
+    float screenWidth = (float)GetScreenWidth(), screenHeight = (float)GetScreenHeight();
+
+    // Keys the query box ignores or would swallow: read them before it runs
+    bool up = IsKeyPressed(KEY_UP) || IsKeyPressedRepeat(KEY_UP), down = IsKeyPressed(KEY_DOWN) || IsKeyPressedRepeat(KEY_DOWN);
+    bool pageUp = IsKeyPressed(KEY_PAGE_UP), pageDown = IsKeyPressed(KEY_PAGE_DOWN);
+    bool enter = IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_KP_ENTER), escape = IsKeyPressed(KEY_ESCAPE);
+
+    float width = palette->width > 0.0f ? palette->width : screenWidth * 0.6f;
+    int rows = palette->visibleRows > 0 ? palette->visibleRows : 10;
+    Rectangle frame = { (screenWidth - width) * 0.5f, screenHeight * 0.15f, width, 0.0f };
+    Rectangle queryBox = { frame.x + padding, frame.y + padding, width - 2.0f * padding, rowHeight + 2.0f * inset };
+    Rectangle list = { queryBox.x, queryBox.y + queryBox.height + padding, queryBox.width, (float)rows * rowHeight };
+    frame.height = list.y + list.height + padding - frame.y;
+
+    // Query box: the shared text input, fed the pointer as popups see it
+    Vector2 savedMouse = rui_ctx->mouse;
+    bool savedPressed = rui_ctx->mousePressed;
+    rui_ctx->mouse = rui_ctx->popupMouse;
+    rui_ctx->mousePressed = rui_ctx->popupPressed;
+    if (rui_ctx->activeTextInput != &palette->input) rui_text_input_set_active(&palette->input); // modal: keep focus
+    rui_popup_scope scope = rui_popup_begin(frame);
+    rui_draw_rect(frame, rui_apply_alpha(rui_ctx->skin->theme.panel.bodyColor));
+    rui_draw_rect_lines(frame, rui_ctx->skin->metrics.border, rui_apply_alpha(rui_ctx->skin->theme.panel.borderColor));
+    rui_undo_log *undoLog = rui_undoLog; // typing a query is not an edit
+    rui_undoLog = NULL;
+    rui_text_input_box(queryBox, &palette->input);
+    rui_undoLog = undoLog;
+    rui_ctx->mouse = savedMouse;
+    rui_ctx->mousePressed = savedPressed;
+    rui_palette_match(palette);
+
+    const char *status = TextFormat("%ld / %ld", palette->resultCount, palette->itemCount);
+    Vector2 statusSize = MeasureTextEx(fs->font, status, (float)fs->size, fs->spacing);
+    rui_draw_text(fs->font, status, (Vector2){ queryBox.x + queryBox.width - inset - statusSize.x, queryBox.y + (queryBox.height - (float)fs->size) * 0.5f },
+                  (float)fs->size, fs->spacing, rui_apply_alpha(bs->border));
+
+    // Keyboard and wheel move through the results
+    long count = palette->resultCount;
+    if (down) palette->highlighted++;
+    if (up) palette->highlighted--;
+    if (pageDown) palette->highlighted += rows;
+    if (pageUp) palette->highlighted -= rows;
+    if (palette->highlighted >= count) palette->highlighted = count - 1;
+    if (palette->highlighted < 0) palette->highlighted = 0;
+    if (up || down || pageUp || pageDown) {
+        double y = (double)palette->highlighted * rowHeight;
+        if (y < palette->scroll) palette->scroll = y;
+        if (y + rowHeight > palette->scroll + list.height) palette->scroll = y + rowHeight - list.height;
+        rui_layout->activity = true;
+    }
+    bool listHovered = CheckCollisionPointRec(rui_ctx->popupMouse, list);
+    if (listHovered) palette->scroll += GetMouseWheelMove() * rui_ctx->skin->metrics.scrollStep * 3.0f;
+    palette->scroll = rui_clamp_offset(palette->scroll, fmax((double)count * rowHeight - list.height, 0.0));
+
+    long hoveredResult = -1;
+    if (listHovered) {
+        double position = floor((palette->scroll + (rui_ctx->popupMouse.y - list.y)) / rowHeight);
+        if (position >= 0.0 && position < (double)count) hoveredResult = (long)position;
+    }
+
+    // Visible results only
+    long first = (long)floor(palette->scroll / rowHeight);
+    long last = (long)fmin((double)count, ceil((palette->scroll + list.height) / rowHeight));
+    unsigned int hash = rui_hash_int((int)count, rui_hash_string(palette->query, 0));
+    char buffer[256];
+    rui_draw_scissor_begin(list);
+    for (long n = first; n < last; ++n) {
+        Rectangle r = { list.x, list.y + (float)((double)n * rowHeight - palette->scroll), list.width, rowHeight };
+        Color normal = rui_apply_alpha(n == palette->highlighted ? bs->hover : tis->background);
+        Color hover = rui_apply_alpha(bs->hover);
+        int row = rui_draw_rect(r, n == hoveredResult ? hover : normal);
+        rui_draw_patch_add(row, GetCollisionRec(r, list), normal, hover, NULL);
+        buffer[0] = '\0';
+        long item = palette->results[n];
+        const char *text = palette->item ? palette->item(item, buffer, (int)sizeof(buffer), palette->userData) : NULL;
+        if (text && text[0]) {
+            rui_draw_text(fs->font, text, (Vector2){ r.x + inset, r.y + inset }, (float)fs->size, fs->spacing, rui_apply_alpha(tis->text));
+            hash = rui_hash_string(text, hash);
+        }
+    }
+    rui_draw_scissor_end();
+    rui_popup_end(scope);
+    rui_layout->panelCacheDirty = true;
+    rui_damage_track(frame, rui_hash_int((int)first, rui_hash_int((int)palette->highlighted, rui_hash_int((int)hoveredResult, hash))));
+
+    // Choose or dismiss
+    long picked = -1;
+    if (enter && palette->highlighted < count) picked = palette->results[palette->highlighted];
+    if (rui_ctx->popupPressed && hoveredResult >= 0) picked = palette->results[hoveredResult];
+    if (picked >= 0) {
+        palette->chosen = picked;
+        rui_palette_close(palette);
+        return true;
     }
+    if (escape || enter || (rui_ctx->popupPressed && !CheckCollisionPointRec(rui_ctx->popupMouse, frame))) rui_palette_close(palette);
+    return false;
 }
 
-float rui_panel_slider(float height, float value, float minValue, float maxValue) { // slider integrated with panel layout
-    if (!rui_panelActive) return value; // bail when no active panel
+// --- Autocomplete ---
+// Words are sorted once and split into a trie whose nodes are laid out breadth-first, so every node's
+// children sit next to each other and their edge bytes form one short contiguous run. Each node also keeps
+// the best frequency below it, which lets a best-first search stop after the top K words of a prefix.
+static RUI_THREAD_LOCAL const char *rui_trieSortingText; // qsort has no context argument
+static RUI_THREAD_LOCAL const long *rui_trieSortingOffsets;
+
+static int rui_trie_word_compare(const void *x, const void *y) {
+    long a = *(const long *)x, b = *(const long *)y;
+    int c = strcmp(rui_trieSortingText + rui_trieSortingOffsets[a], rui_trieSortingText + rui_trieSortingOffsets[b]);
+    return c != 0 ? c : (a < b ? -1 : 1);
+}
 
-    float innerWidth = rui_panelInnerRight - rui_panelInnerLeft; // available width
-    float targetWidth = rui_panelContentWidth; // requested widget width
-    if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp to interior
+void rui_trie_free(rui_trie *trie) {
+    if (!trie) return;
+    rui_free(trie->nodes);
+    rui_free(trie->edges);
+    rui_free(trie->frequency);
+    rui_free(trie->heapKey);
+    rui_free(trie->heapEntry);
+    *trie = (rui_trie){ 0 };
+}
 
-    float x = rui_panelInnerLeft; // default placement at left
-    if (targetWidth < innerWidth) { // adjust for alignment when width smaller
-        if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
-            x = rui_panelInnerLeft + (innerWidth - targetWidth) * 0.5f; // center slider
-        } else if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
-            x = rui_panelInnerRight - targetWidth; // align to right edge
+bool rui_trie_build(rui_trie *trie, long wordCount, rui_item_fn word, const unsigned *frequency, void *userData) {
+    if (!trie) return false;
+    rui_trie_free(trie);
+    if (wordCount < 0 || wordCount > 0x7ffffffeL) return false; // word indices are stored as int
+    trie->word = word;
+    trie->userData = userData;
+    trie->wordCount = wordCount;
+
+    // Copy the vocabulary and sort it; each node then owns one contiguous range of sorted words
+    size_t slots = (size_t)(wordCount > 0 ? wordCount : 1);
+    long *offsets = (long *)rui_realloc(NULL, slots * sizeof(long));
+    long *order = (long *)rui_realloc(NULL, slots * sizeof(long));
+    trie->frequency = (unsigned *)rui_realloc(NULL, slots * sizeof(unsigned));
+    char *arena = NULL;
+    long size = 0, capacity = 0;
+    bool ok = offsets && order && trie->frequency;
+    char buffer[256];
+    for (long i = 0; ok && i < wordCount; ++i) {
+        buffer[0] = '\0';
+        const char *w = word ? word(i, buffer, (int)sizeof(buffer), userData) : NULL;
+        if (!w) w = "";
+        long length = (long)strlen(w) + 1;
+        if (size + length > capacity) {
+            long grown = capacity > 0 ? capacity * 2 : 65536;
+            while (grown < size + length) grown *= 2;
+            char *resized = (char *)rui_realloc(arena, (size_t)grown);
+            if (!resized) { ok = false; break; }
+            arena = resized;
+            capacity = grown;
         }
+        memcpy(arena + size, w, (size_t)length);
+        offsets[i] = size;
+        order[i] = i;
+        trie->frequency[i] = frequency ? frequency[i] : 1u;
+        size += length;
+    }
+    if (ok) {
+        rui_trieSortingText = arena;
+        rui_trieSortingOffsets = offsets;
+        qsort(order, (size_t)wordCount, sizeof(long), rui_trie_word_compare);
     }
 
-    Rectangle bounds = { x, rui_panelCursorY - rui_scrollOffset, targetWidth, height }; // slider rectangle
-    float newValue = rui_slider(bounds, value, minValue, maxValue); // draw slider using core helper
-
-    rui_panelCursorY += height + rui_panelSpacing; // advance cursor after slider
-    rui_contentHeight = rui_panelCursorY - (rui_currentPanel.y + rui_panelHeaderHeight); // update content height
+    // Breadth-first: the node array doubles as the work queue, with each node's word range kept alongside
+    int nodeCapacity = 0, rangeCapacity = 0, edgeCapacity = 0;
+    long *range = NULL; // lo, hi and depth per node
+    if (ok) {
+        trie->nodes = (rui_trie_node *)rui_grow(NULL, &nodeCapacity, 1, (int)sizeof(rui_trie_node));
+        trie->edges = (unsigned char *)rui_grow(NULL, &edgeCapacity, 1, 1);
+        range = (long *)rui_grow(NULL, &rangeCapacity, 3, (int)sizeof(long));
+        ok = trie->nodes && trie->edges && range;
+    }
+    if (ok) {
+        trie->nodes[0] = (rui_trie_node){ 0, -1, 0, 0 };
+        trie->edges[0] = 0;
+        range[0] = 0;
+        range[1] = wordCount;
+        range[2] = 0;
+        trie->nodeCount = 1;
+    }
+    for (int n = 0; ok && n < trie->nodeCount; ++n) {
+        long lo = range[3 * n], hi = range[3 * n + 1], depth = range[3 * n + 2];
+        long i = lo;
+        for (; i < hi && arena[offsets[order[i]] + depth] == '\0'; ++i) { // the word ending here (duplicates keep the most frequent)
+            int w = (int)order[i];
+            if (trie->nodes[n].word < 0 || trie->frequency[w] > trie->frequency[trie->nodes[n].word]) trie->nodes[n].word = w;
+        }
+        trie->nodes[n].first = trie->nodeCount;
+        while (i < hi) { // one child per distinct next byte
+            unsigned char c = (unsigned char)arena[offsets[order[i]] + depth];
+            long j = i + 1;
+            while (j < hi && (unsigned char)arena[offsets[order[j]] + depth] == c) j++;
+            int child = trie->nodeCount;
+            rui_trie_node *nodes = (rui_trie_node *)rui_grow(trie->nodes, &nodeCapacity, child + 1, (int)sizeof(rui_trie_node));
+            unsigned char *edges = (unsigned char *)rui_grow(trie->edges, &edgeCapacity, child + 1, 1);
+            if (nodes) trie->nodes = nodes;
+            if (edges) trie->edges = edges;
+            long *ranges = (long *)rui_grow(range, &rangeCapacity, 3 * (child + 1), (int)sizeof(long));
+            if (ranges) range = ranges;
+            if (!nodes || !edges || !ranges || child >= 0x7ffffffe) { ok = false; break; }
+            trie->nodes[child] = (rui_trie_node){ 0, -1, 0, 0 };
+            trie->edges[child] = c;
+            range[3 * child] = i;
+            range[3 * child + 1] = j;
+            range[3 * child + 2] = depth + 1;
+            trie->nodeCount++;
+            i = j;
+        }
+        trie->nodes[n].childCount = (unsigned short)(trie->nodeCount - trie->nodes[n].first);
+    }
+    rui_free(range);
+    rui_free(arena);
+    rui_free(offsets);
+    rui_free(order);
+    if (!ok) {
+        rui_trie_free(trie);
+        return false;
+    }
 
-    return newValue; // return possibly updated value
+    for (int n = trie->nodeCount - 1; n >= 0; --n) { // children come after their parent, so one backwards pass fills best
+        rui_trie_node *node = &trie->nodes[n];
+        unsigned best = node->word >= 0 ? trie->frequency[node->word] : 0u;
+        for (int c = 0; c < node->childCount; ++c) {
+            if (trie->nodes[node->first + c].best > best) best = trie->nodes[node->first + c].best;
+        }
+        node->best = best;
+    }
+    return true;
 }
 
-float rui_panel_slider_call(float height, float value, float minValue, float maxValue, void (*callback)(float, void *), void *userData) { // panel slider helper with callback
-    float newValue = rui_panel_slider(height, value, minValue, maxValue); // reuse layout slider
-    if (callback && newValue != value) {
-        callback(newValue, userData); // notify user when value changes
+static int rui_trie_find(const rui_trie *trie, const char *prefix, int length) { // O(length) walk, -1 when no word has the prefix
+    if (trie->nodeCount == 0) return -1;
+    int n = 0;
+    for (int i = 0; i < length; ++i) {
+        const rui_trie_node *node = &trie->nodes[n];
+        const unsigned char *edge = trie->edges + node->first;
+        unsigned char c = (unsigned char)prefix[i];
+        int k = 0;
+        while (k < node->childCount && edge[k] < c) k++; // sorted, usually a handful of bytes
+        if (k == node->childCount || edge[k] != c) return -1;
+        n = node->first + k;
     }
-    return newValue; // return slider value
+    return n;
 }
 
-bool rui_panel_toggle(bool value, const char *label) { // toggle integrated with panel layout
-    if (!rui_panelActive) return value; // ignore when no panel active
+static bool rui_trie_heap_before(const rui_trie *trie, int a, int b) { // higher key first; words before subtrees; then breadth-first order
+    if (trie->heapKey[a] != trie->heapKey[b]) return trie->heapKey[a] > trie->heapKey[b];
+    int ea = trie->heapEntry[a], eb = trie->heapEntry[b];
+    if ((ea < 0) != (eb < 0)) return ea < 0;
+    return ea < 0 ? ea > eb : ea < eb;
+}
 
-    float height = (float)rui_themeCurrent.textFont.size + 8.0f; // default toggle height from font
-    if (height < 24.0f) height = 24.0f;
-    float innerWidth = rui_panelInnerRight - rui_panelInnerLeft; // usable width
-    float targetWidth = rui_panelContentWidth; // requested width
-    if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp
+static bool rui_trie_heap_push(rui_trie *trie, int *count, unsigned key, int entry) { // entry: node, or -(node + 1) for its word
+    int needed = *count + 1;
+    int keyCapacity = trie->heapCapacity;
+    unsigned *keys = (unsigned *)rui_grow(trie->heapKey, &keyCapacity, needed, (int)sizeof(unsigned));
+    if (!keys) return false;
+    trie->heapKey = keys;
+    int entryCapacity = trie->heapCapacity;
+    int *entries = (int *)rui_grow(trie->heapEntry, &entryCapacity, needed, (int)sizeof(int));
+    if (!entries) return false;
+    trie->heapEntry = entries;
+    trie->heapCapacity = keyCapacity < entryCapacity ? keyCapacity : entryCapacity;
+
+    int i = (*count)++;
+    trie->heapKey[i] = key;
+    trie->heapEntry[i] = entry;
+    while (i > 0 && rui_trie_heap_before(trie, i, (i - 1) / 2)) { // sift up
+        int parent = (i - 1) / 2;
+        unsigned k = trie->heapKey[i]; trie->heapKey[i] = trie->heapKey[parent]; trie->heapKey[parent] = k;
+        int e = trie->heapEntry[i]; trie->heapEntry[i] = trie->heapEntry[parent]; trie->heapEntry[parent] = e;
+        i = parent;
+    }
+    return true;
+}
 
-    float x = rui_panelInnerLeft; // base x position
-    if (targetWidth < innerWidth) {
-        if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
-            x = rui_panelInnerLeft + (innerWidth - targetWidth) * 0.5f;
-        } else if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
-            x = rui_panelInnerRight - targetWidth;
-        }
+static int rui_trie_heap_pop(rui_trie *trie, int *count) {
+    int top = trie->heapEntry[0];
+    int last = --(*count);
+    trie->heapKey[0] = trie->heapKey[last];
+    trie->heapEntry[0] = trie->heapEntry[last];
+    for (int i = 0;;) { // sift down
+        int best = i, left = 2 * i + 1, right = left + 1;
+        if (left < last && rui_trie_heap_before(trie, left, best)) best = left;
+        if (right < last && rui_trie_heap_before(trie, right, best)) best = right;
+        if (best == i) break;
+        unsigned k = trie->heapKey[i]; trie->heapKey[i] = trie->heapKey[best]; trie->heapKey[best] = k;
+        int e = trie->heapEntry[i]; trie->heapEntry[i] = trie->heapEntry[best]; trie->heapEntry[best] = e;
+        i = best;
     }
+    return top;
+}
 
-    Rectangle bounds = { x, rui_panelCursorY - rui_scrollOffset, targetWidth, height }; // overall toggle bounds
-    bool newValue = rui_toggle(bounds, value, label); // draw toggle using base helper
+int rui_trie_complete(rui_trie *trie, const char *prefix, long *out, int maxCount) {
+    if (!trie || !prefix || !out || maxCount <= 0) return 0;
+    int start = rui_trie_find(trie, prefix, (int)strlen(prefix));
+    if (start < 0) return 0;
+    int found = 0, queued = 0;
+    if (!rui_trie_heap_push(trie, &queued, trie->nodes[start].best, start)) return 0;
+    while (queued > 0 && found < maxCount) { // a subtree is only opened when its best word could still rank
+        int entry = rui_trie_heap_pop(trie, &queued);
+        if (entry < 0) {
+            out[found++] = trie->nodes[-entry - 1].word;
+            continue;
+        }
+        const rui_trie_node *node = &trie->nodes[entry];
+        bool ok = true;
+        if (node->word >= 0) ok = rui_trie_heap_push(trie, &queued, trie->frequency[node->word], -entry - 1);
+        for (int c = 0; ok && c < node->childCount; ++c) ok = rui_trie_heap_push(trie, &queued, trie->nodes[node->first + c].best, node->first + c);
+        if (!ok) break;
+    }
+    return found;
+}
 
-    rui_panelCursorY += height + rui_panelSpacing; // advance cursor
-    rui_contentHeight = rui_panelCursorY - (rui_currentPanel.y + rui_panelHeaderHeight); // update content height
+static int rui_autocomplete_word_start(const rui_text_input *input) { // start of the word ending at the caret
+    int start = input->cursor;
+    while (start > 0 && input->buffer[start - 1] != ' ' && input->buffer[start - 1] != '\t') start--;
+    return start;
+}
 
-    return newValue; // return toggle state
+static bool rui_autocomplete_accept(rui_autocomplete *complete, rui_text_input *input, int start) { // replace the word before the caret
+    char buffer[256];
+    buffer[0] = '\0';
+    const rui_trie *trie = complete->trie;
+    const char *word = trie->word ? trie->word(complete->suggestions[complete->highlighted], buffer, (int)sizeof(buffer), trie->userData) : NULL;
+    if (!word) return false;
+    int wordLength = (int)strlen(word);
+    int tail = input->length - input->cursor;
+    if (start + wordLength + tail >= input->capacity) return false; // would not fit
+    memmove(input->buffer + start + wordLength, input->buffer + input->cursor, (size_t)tail + 1);
+    memcpy(input->buffer + start, word, (size_t)wordLength);
+    input->length = start + wordLength + tail;
+    input->cursor = start + wordLength;
+    if (wordLength < (int)sizeof(complete->prefix)) memcpy(complete->prefix, word, (size_t)wordLength + 1); // the completed word is not a new prefix
+    complete->dismissed = true;
+    return true;
 }
 
-bool rui_panel_toggle_call(bool value, const char *label, void (*callback)(bool, void *), void *userData) { // panel toggle helper with callback
-    bool newValue = rui_panel_toggle(value, label); // draw toggle using layout helper
-    if (callback && newValue != value) {
-        callback(newValue, userData); // notify about state change
+bool rui_text_input_box_complete(Rectangle bounds, rui_text_input *input, rui_autocomplete *complete) {
+    bool changed = rui_text_input_box(bounds, input);
+    if (!complete || !input || !input->buffer) return changed;
+    if (!complete->trie || rui_ctx->activeTextInput != input || rui_layout != &rui_ctx->layout) { // suggestions follow focus
+        complete->count = 0;
+        complete->prefix[0] = '\0';
+        return changed;
     }
-    return newValue; // return toggle state
+
+    // Fetch suggestions only when the word before the caret (or the vocabulary) changes
+    int start = rui_autocomplete_word_start(input);
+    int length = input->cursor - start;
+    if (length >= (int)sizeof(complete->prefix)) length = 0; // too long to be a vocabulary word
+    char prefix[sizeof(complete->prefix)];
+    memcpy(prefix, input->buffer + start, (size_t)length);
+    prefix[length] = '\0';
+    if (strcmp(prefix, complete->prefix) != 0 || complete->prefixTrie != complete->trie) {
+        memcpy(complete->prefix, prefix, (size_t)length + 1);
+        complete->prefixTrie = complete->trie;
+        int limit = complete->maxSuggestions > 0 ? complete->maxSuggestions : 8;
+        if (limit > RUI_AUTOCOMPLETE_MAX) limit = RUI_AUTOCOMPLETE_MAX;
+        complete->count = length > 0 ? rui_trie_complete(complete->trie, prefix, complete->suggestions, limit) : 0;
+        complete->highlighted = 0;
+        complete->dismissed = false;
+    }
+    if (complete->count == 0 || complete->dismissed) return changed;
+
+    // Tab accepts, arrows pick (the text box ignores these keys)
+    if (IsKeyPressed(KEY_DOWN) || IsKeyPressedRepeat(KEY_DOWN)) complete->highlighted = (complete->highlighted + 1) % complete->count;
+    if (IsKeyPressed(KEY_UP) || IsKeyPressedRepeat(KEY_UP)) complete->highlighted = (complete->highlighted + complete->count - 1) % complete->count;
+    if (IsKeyPressed(KEY_TAB)) {
+        rui_undo_text_begin(input);
+        bool accepted = rui_autocomplete_accept(complete, input, start);
+        rui_undo_text_end(input);
+        if (accepted) {
+            rui_layout->activity = true;
+            return true;
+        }
+    }
+
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    const rui_button_style *bs = &rui_ctx->skin->theme.button;
+    const rui_text_input_style *tis = &rui_ctx->skin->theme.textInput;
+    float inset = rui_ctx->skin->metrics.textInset;
+    float rowHeight = (float)fs->size + 2.0f * inset;
+    Rectangle popup = { bounds.x, bounds.y + bounds.height, bounds.width, (float)complete->count * rowHeight };
+    if (popup.y + popup.height > (float)GetScreenHeight() && bounds.y - popup.height >= 0.0f) popup.y = bounds.y - popup.height;
+
+    int hoveredRow = -1;
+    if (CheckCollisionPointRec(rui_ctx->popupMouse, popup)) hoveredRow = (int)((rui_ctx->popupMouse.y - popup.y) / rowHeight);
+    if (hoveredRow >= complete->count) hoveredRow = -1;
+    if (hoveredRow >= 0 && rui_ctx->popupPressed) {
+        complete->highlighted = hoveredRow;
+        rui_undo_text_begin(input);
+        bool accepted = rui_autocomplete_accept(complete, input, start);
+        rui_undo_text_end(input);
+        if (accepted) {
+            rui_layout->activity = true;
+            return true;
+        }
+    }
+
+    rui_popup_scope scope = rui_popup_begin(popup);
+    rui_draw_rect(popup, rui_apply_alpha(tis->background));
+    unsigned int hash = rui_hash_int(complete->highlighted, rui_hash_int(hoveredRow, 0));
+    char buffer[256];
+    for (int i = 0; i < complete->count; ++i) {
+        Rectangle r = { popup.x, popup.y + (float)i * rowHeight, popup.width, rowHeight };
+        Color normal = rui_apply_alpha(i == complete->highlighted ? bs->hover : tis->background);
+        Color hover = rui_apply_alpha(bs->hover);
+        int row = rui_draw_rect(r, i == hoveredRow ? hover : normal);
+        rui_draw_patch_add(row, r, normal, hover, NULL);
+        buffer[0] = '\0';
+        const rui_trie *trie = complete->trie;
+        const char *word = trie->word ? trie->word(complete->suggestions[i], buffer, (int)sizeof(buffer), trie->userData) : NULL;
+        if (word && word[0]) {
+            rui_draw_text(fs->font, word, (Vector2){ r.x + inset, r.y + inset }, (float)fs->size, fs->spacing, rui_apply_alpha(tis->text));
+            hash = rui_hash_string(word, hash);
+        }
+    }
+    rui_draw_rect_lines(popup, rui_ctx->skin->metrics.border, rui_apply_alpha(tis->borderActive));
+    rui_popup_end(scope);
+    rui_damage_track(popup, hash);
+    return changed;
 }
 
-bool rui_panel_text_input(float height, rui_text_input *input) { // integrate text input with panel layout
-    if (!rui_panelActive) return false; // ignore when panel inactive
+bool rui_panel_text_input_complete(float height, rui_text_input *input, rui_autocomplete *complete) {
+    if (!rui_layout->panelActive || rui_layout->panelCacheHit) return false;
 
-    float innerWidth = rui_panelInnerRight - rui_panelInnerLeft; // usable width
-    float targetWidth = rui_panelContentWidth; // requested width
+    float innerWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft; // usable width
+    float targetWidth = rui_layout->panelContentWidth; // requested width
     if (targetWidth <= 0.0f || targetWidth > innerWidth) targetWidth = innerWidth; // clamp width
 
-    float x = rui_panelInnerLeft; // base x coordinate
+    float x = rui_layout->panelInnerLeft; // base x coordinate
     if (targetWidth < innerWidth) {
-        if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
-            x = rui_panelInnerLeft + (innerWidth - targetWidth) * 0.5f;
-        } else if (rui_currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
-            x = rui_panelInnerRight - targetWidth;
+        if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_CENTER) {
+            x = rui_layout->panelInnerLeft + (innerWidth - targetWidth) * 0.5f;
+        } else if (rui_layout->currentPanelStyle.contentAlign == RUI_ALIGN_RIGHT) {
+            x = rui_layout->panelInnerRight - targetWidth;
         }
     }
 
-    Rectangle bounds = { x, rui_panelCursorY - rui_scrollOffset, targetWidth, height }; // text box bounds
-    bool changed = rui_text_input_box(bounds, input); // draw input and handle typing
-
-    rui_panelCursorY += height + rui_panelSpacing; // advance cursor after input field
-    rui_contentHeight = rui_panelCursorY - (rui_currentPanel.y + rui_panelHeaderHeight); // update content height
-
-    return changed; // return whether text changed
+    Rectangle bounds = { x, rui_panel_place_y(), targetWidth, height }; // the popup takes no layout space
+    rui_panel_advance(height + rui_layout->panelSpacing);
+    return rui_text_input_box_complete(bounds, input, complete);
 }
 
-bool rui_panel_begin_closable(Rectangle bounds, const char *title, bool scrollable, const char *closeLabel) { // begin default-styled closable panel
-    return rui_panel_begin_closable_fade(bounds, title, scrollable, 1.0f, closeLabel);
+// --- Property Grid ---
+// Rows outside the viewport create no widgets. After the visible rows have run, one pass compares every
+// field with its packed copy from the previous call, which also catches edits the app made elsewhere.
+static double rui_field_get(const unsigned char *data, const rui_field *field) { // numeric value of a FLOAT or INT field
+    if (field->type == RUI_FIELD_FLOAT) {
+        if (field->size == (int)sizeof(double)) { double v; memcpy(&v, data, sizeof(v)); return v; }
+        float v; memcpy(&v, data, sizeof(v)); return v;
+    }
+    switch (field->size) {
+        case 1: { signed char v; memcpy(&v, data, sizeof(v)); return v; }
+        case 2: { short v; memcpy(&v, data, sizeof(v)); return v; }
+        case 8: { long long v; memcpy(&v, data, sizeof(v)); return (double)v; }
+        default: { int v; memcpy(&v, data, sizeof(v)); return v; }
+    }
 }
 
-bool rui_panel_begin_ex_closable(Rectangle bounds, const char *title, bool scrollable, rui_panel_style style, const char *closeLabel) { // styled panel with close button
-    return rui_panel_begin_ex_closable_fade(bounds, title, scrollable, style, 1.0f, closeLabel);
+static void rui_field_put(unsigned char *data, const rui_field *field, double value) {
+    if (field->type == RUI_FIELD_FLOAT) {
+        if (field->size == (int)sizeof(double)) memcpy(data, &value, sizeof(value));
+        else { float v = (float)value; memcpy(data, &v, sizeof(v)); }
+        return;
+    }
+    value = floor(value + 0.5);
+    switch (field->size) {
+        case 1: { signed char v = (signed char)value; memcpy(data, &v, sizeof(v)); break; }
+        case 2: { short v = (short)value; memcpy(data, &v, sizeof(v)); break; }
+        case 8: { long long v = (long long)value; memcpy(data, &v, sizeof(v)); break; }
+        default: { int v = (int)value; memcpy(data, &v, sizeof(v)); break; }
+    }
 }
 
-bool rui_panel_begin_closable_fade(Rectangle bounds, const char *title, bool scrollable, float alpha, const char *closeLabel) {
-    rui_panelCloseRequested = true;
-    rui_panelCloseLabel = closeLabel;
-    rui_panelClosePressed = false;
-    rui_panel_begin_fade(bounds, title, scrollable, alpha);
-    return rui_panelClosePressed;
+bool rui_property_grid_init(rui_property_grid *grid, const rui_field *fields, int fieldCount) {
+    if (!grid) return false;
+    *grid = (rui_property_grid){ 0 };
+    if (!fields || fieldCount <= 0) return false;
+    for (int i = 0; i < fieldCount; ++i) { // rows copy field->size bytes through fixed-size buffers: reject sizes they can't hold
+        int size = fields[i].size;
+        bool valid = false;
+        switch (fields[i].type) {
+            case RUI_FIELD_FLOAT: valid = size == (int)sizeof(float) || size == (int)sizeof(double); break;
+            case RUI_FIELD_INT: valid = size == 1 || size == 2 || size == 4 || size == 8; break;
+            case RUI_FIELD_BOOL: valid = size == (int)sizeof(bool); break;
+            case RUI_FIELD_TEXT: valid = size >= 1; break;
+        }
+        if (!valid) return false;
+    }
+    grid->fields = fields;
+    grid->fieldCount = fieldCount;
+    grid->changed = (int *)rui_realloc(NULL, (size_t)fieldCount * sizeof(int));
+    grid->snapshotOffset = (int *)rui_realloc(NULL, (size_t)fieldCount * sizeof(int));
+    grid->inputs = (rui_text_input *)rui_realloc(NULL, (size_t)fieldCount * sizeof(rui_text_input));
+    int size = 0;
+    for (int i = 0; grid->snapshotOffset && i < fieldCount; ++i) {
+        grid->snapshotOffset[i] = size;
+        size += fields[i].size;
+        if (fields[i].offset + (size_t)fields[i].size > grid->instanceSize) grid->instanceSize = fields[i].offset + (size_t)fields[i].size;
+    }
+    grid->snapshot = (unsigned char *)rui_realloc(NULL, (size_t)(size > 0 ? size : 1));
+    if (!grid->changed || !grid->snapshotOffset || !grid->inputs || !grid->snapshot) {
+        rui_property_grid_free(grid);
+        return false;
+    }
+    for (int i = 0; i < fieldCount; ++i) grid->inputs[i] = rui_text_input_init(NULL, 0);
+    return true;
 }
 
-bool rui_panel_begin_ex_closable_fade(Rectangle bounds, const char *title, bool scrollable, rui_panel_style style, float alpha, const char *closeLabel) {
-    rui_panelCloseRequested = true;
-    rui_panelCloseLabel = closeLabel;
-    rui_panelClosePressed = false;
-    rui_panel_begin_ex_fade(bounds, title, scrollable, style, alpha);
-    return rui_panelClosePressed;
+void rui_property_grid_free(rui_property_grid *grid) {
+    if (!grid) return;
+    if (grid->inputs && rui_ctx->activeTextInput >= grid->inputs && rui_ctx->activeTextInput < grid->inputs + grid->fieldCount) {
+        rui_text_input_set_active(NULL); // focus must not outlive the grid
+    }
+    rui_free(grid->changed);
+    rui_free(grid->snapshotOffset);
+    rui_free(grid->inputs);
+    rui_free(grid->snapshot);
+    *grid = (rui_property_grid){ 0 };
 }
 
-void rui_panel_end(void) { // finish panel rendering and handle scrollbars
-    if (rui_panelActive) { // only proceed if a panel was begun
-        EndScissorMode(); // stop clipping so scrollbar can draw outside content area
-
-        if (rui_panelScrollable && rui_contentHeight > (rui_currentPanel.height - rui_panelHeaderHeight)) { // only show scrollbar when needed
-            float viewHeight = rui_currentPanel.height - rui_panelHeaderHeight; // visible content height
-            float maxOffset = rui_contentHeight - viewHeight; // maximum scroll offset possible
-            if (maxOffset < 0) maxOffset = 0; // guard against negatives (precision)
-
-            // Draw track + thumb
-            float ratio = viewHeight / rui_contentHeight; // portion of content visible
-            float barHeight = viewHeight * ratio; // scrollbar thumb height proportional to ratio
-            float trackY = rui_currentPanel.y + rui_panelHeaderHeight; // scrollbar track start at content top
-            float travel = viewHeight - barHeight; // distance thumb can travel along track
-
-            Rectangle scrollTrack = { // rectangle representing scrollbar track
-                rui_currentPanel.x + rui_currentPanel.width - 10, // align track to right edge
-                trackY, // start track below panel header
-                8, // fixed track width
-                viewHeight // track height matches viewable content
-            };
-
-            float barY = trackY + (maxOffset > 0 ? (rui_scrollOffset / maxOffset) * travel : 0.0f); // thumb position based on scroll fraction
-            Rectangle scrollBar = {scrollTrack.x, barY, scrollTrack.width, barHeight}; // rectangle for draggable thumb
-
-            DrawRectangleRec(scrollTrack, rui_apply_alpha(LIGHTGRAY)); // draw track background
-            bool hovered = CheckCollisionPointRec(rui_mouse, scrollBar); // detect hover over thumb
-            Color barColor = rui_draggingScrollbar ? BLUE : (hovered ? GRAY : DARKGRAY); // change color when dragging or hovered
-            DrawRectangleRec(scrollBar, rui_apply_alpha(barColor)); // draw thumb with computed color
-
-            // Drag input
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && hovered) { // start dragging when thumb clicked
-                rui_draggingScrollbar = true; // flag dragging state
-                rui_dragOffsetY = rui_mouse.y - scrollBar.y; // remember grab offset within thumb
-            }
-
-            if (rui_draggingScrollbar) { // while in drag mode
-                if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) { // continue while button is held
-                    float newBarY = rui_mouse.y - rui_dragOffsetY; // proposed thumb position following mouse
-                    newBarY = Clamp(newBarY, trackY, trackY + travel); // constrain thumb to track bounds
-                    if (travel > 0) { // avoid divide-by-zero when no travel
-                        rui_scrollOffset = ((newBarY - trackY) / travel) * maxOffset; // convert thumb position to scroll offset
-                    }
-                } else { // mouse button released
-                    rui_draggingScrollbar = false; // exit dragging state
-                }
-            }
-
-            // ✅ Final clamp for both drag + wheel
-            rui_scrollOffset = Clamp(rui_scrollOffset, 0, maxOffset); // enforce valid offset after interactions
-        } else {
-            if (rui_panelScrollable) { // scrollable panel with no overflow resets offset
-                rui_scrollOffset = 0; // keep offset zero when content fits
-            } else { // restore prior offset after non-scrollable panels so other panels retain their position
-                rui_scrollOffset = rui_scrollOffsetBeforePanel; // reinstate offset saved at begin
-            }
+static void rui_property_row(rui_property_grid *grid, int index, unsigned char *data, Rectangle row, float labelWidth) { // label plus the field's control
+    const rui_field *field = &grid->fields[index];
+    const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+    float textY = row.y + (row.height - (float)fs->size) * 0.5f;
+    if (field->name) rui_draw_text(fs->font, field->name, (Vector2){ row.x, textY }, (float)fs->size, fs->spacing, rui_apply_alpha(rui_layout->currentPanelStyle.labelColor));
+
+    Rectangle value = { row.x + labelWidth, row.y, row.width - labelWidth, row.height };
+    float step = field->step > 0.0f ? field->step : 1.0f;
+    const char *readout = NULL; // numeric value as drawn, for damage tracking
+    if (field->type == RUI_FIELD_BOOL) {
+        bool current = *(bool *)data;
+        bool next = rui_toggle((Rectangle){ value.x, value.y, row.height, row.height }, current, NULL);
+        if (next != current) *(bool *)data = next;
+        rui_undo_value(data, &current, &next, (int)sizeof(bool), false);
+    } else if (field->type == RUI_FIELD_TEXT) {
+        rui_text_input *input = &grid->inputs[index];
+        input->buffer = (char *)data; // rebound every frame: the instance may have changed
+        input->capacity = field->size;
+        data[field->size - 1] = '\0';
+        input->length = (int)strlen((const char *)data);
+        if (input->cursor > input->length) input->cursor = input->length;
+        rui_text_input_box(value, input);
+    } else {
+        double current = rui_field_get(data, field);
+        const char *text = field->type == RUI_FIELD_INT ? TextFormat("%.0f", current) : TextFormat("%.3g", current);
+        readout = text;
+        Vector2 textSize = MeasureTextEx(fs->font, text, (float)fs->size, fs->spacing);
+        double next = current;
+        unsigned char before[8]; // widest field: double or long long
+        memcpy(before, data, (size_t)field->size);
+        bool held = false;
+        if (field->max > field->min) { // slider with the value to its right
+            float readoutWidth = fmaxf(textSize.x, value.width * 0.25f);
+            Rectangle slider = { value.x, value.y, fmaxf(value.width - readoutWidth - rui_ctx->skin->metrics.textInset, 0.0f), value.height };
+            float moved = rui_slider(slider, (float)current, field->min, field->max);
+            held = rui_layout->sliderHeld;
+            if (moved != (float)current) next = field->type == RUI_FIELD_INT ? field->min + floor((moved - field->min) / step + 0.5) * step : moved;
+            rui_draw_text(fs->font, text, (Vector2){ value.x + value.width - textSize.x, textY }, (float)fs->size, fs->spacing, rui_apply_alpha(rui_layout->currentPanelStyle.labelColor));
+        } else { // unbounded: - value +
+            Rectangle minus = { value.x, value.y, row.height, row.height };
+            Rectangle plus = { value.x + value.width - row.height, value.y, row.height, row.height };
+            if (rui_button("-", minus)) next = current - step;
+            if (rui_button("+", plus)) next = current + step;
+            rui_draw_text(fs->font, text, (Vector2){ value.x + (value.width - textSize.x) * 0.5f, textY }, (float)fs->size, fs->spacing, rui_apply_alpha(rui_layout->currentPanelStyle.labelColor));
         }
+        if (next != current) rui_field_put(data, field, next);
+        rui_undo_value(data, before, data, field->size, held); // a drag becomes one entry
+    }
+    rui_damage_track(row, rui_hash_string(readout, rui_hash_string(field->name, 0))); // name and readout are plain text: steppers and game-side edits repaint the row
+}
 
-        if (rui_panelScrollable) { // only update prev height for scrollable panels
-            rui_prevContentHeight = rui_contentHeight; // store current content height for next frame
-            rui_hasPrevContent = true; // mark that we now have previous content data
+int rui_panel_property_grid(rui_property_grid *grid, void *instance) {
+    if (!grid || !grid->fields || !grid->snapshot || !instance) return 0;
+    unsigned char *base = (unsigned char *)instance;
+    grid->changedCount = 0;
+
+    if (rui_layout->panelActive && !rui_layout->panelCacheHit) {
+        const rui_font_style *fs = &rui_ctx->skin->metrics.textFont;
+        float rowHeight = grid->rowHeight > 0.0f ? grid->rowHeight : (float)fs->size + 2.0f * rui_ctx->skin->metrics.textInset;
+        float stride = rowHeight + rui_layout->panelSpacing;
+        float innerWidth = rui_layout->panelInnerRight - rui_layout->panelInnerLeft;
+        float width = rui_layout->panelContentWidth > 0.0f && rui_layout->panelContentWidth < innerWidth ? rui_layout->panelContentWidth : innerWidth;
+        float labelWidth = grid->labelWidth > 0.0f ? fminf(grid->labelWidth, width) : width * 0.4f;
+
+        double top = rui_panel_cursor(), viewTop, viewBottom;
+        rui_panel_visible_range(&viewTop, &viewBottom);
+        int first = (int)fmax(0.0, floor((viewTop - top) / stride));
+        int last = (int)fmin((double)grid->fieldCount, ceil((viewBottom - top) / stride));
+        for (int i = first; i < last; ++i) { // only rows in view create widgets
+            Rectangle row = { rui_layout->panelInnerLeft, rui_panel_screen_y(top + (double)i * stride), width, rowHeight };
+            rui_property_row(grid, i, base + grid->fields[i].offset, row, labelWidth);
         }
-        rui_panelActive = false; // clear active flag until next panel begin
-        rui_panelContentWidth = 0.0f; // reset content width override after finishing panel
+        rui_panel_advance((double)grid->fieldCount * stride);
+    }
 
-        if (rui_panelAlphaApplied) {
-            rui_pop_alpha();
-            rui_panelAlphaApplied = false;
-        }
+    // Change detection over the packed snapshot
+    bool sameInstance = grid->snapshotOf == instance;
+    if (!sameInstance && rui_ctx->activeTextInput >= grid->inputs && rui_ctx->activeTextInput < grid->inputs + grid->fieldCount) {
+        rui_text_input_set_active(NULL); // a different instance: don't keep typing into it
+    }
+    if (!sameInstance && grid->snapshotOf && rui_undoLog && rui_shared_owner()) { // the old instance may be freed next: undo must not write into it
+        rui_undo_forget(rui_undoLog, grid->snapshotOf, grid->instanceSize);
+    }
+    for (int i = 0; i < grid->fieldCount; ++i) {
+        const rui_field *field = &grid->fields[i];
+        unsigned char *copy = grid->snapshot + grid->snapshotOffset[i];
+        const unsigned char *data = base + field->offset;
+        bool differs = field->type == RUI_FIELD_TEXT ? strncmp((const char *)copy, (const char *)data, (size_t)field->size) != 0
+                                                     : memcmp(copy, data, (size_t)field->size) != 0;
+        if (!differs) continue;
+        memcpy(copy, data, (size_t)field->size);
+        if (sameInstance) grid->changed[grid->changedCount++] = i;
     }
+    grid->snapshotOf = instance;
+    return grid->changedCount;
 }
 
 #endif // RUI_IMPLEMENTATION // end implementation section